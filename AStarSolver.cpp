@@ -0,0 +1,56 @@
+/*
+ * AStarSolver.cpp - A* search strategy implementation
+ */
+
+#include "AStarSolver.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+bool AStarSolver::search(const MazeGrid& grid, int start, int goal, SolverWorkspace& workspace,
+                         vector<Cell>& path, SolveStats& stats) {
+    workspace.begin(grid.getCellCount());
+    vector<OpenEntry>& open = workspace.openList();
+    
+    int goalRow = grid.rowOf(goal);
+    int goalCol = grid.colOf(goal);
+    auto heuristic = [&](int idx) {
+        return abs(grid.rowOf(idx) - goalRow) + abs(grid.colOf(idx) - goalCol);
+    };
+    
+    workspace.visit(start, -1, 0);
+    open.push_back({heuristic(start), 0, start});
+    
+    while (!open.empty()) {
+        pop_heap(open.begin(), open.end(), openEntryAfter);
+        OpenEntry current = open.back();
+        open.pop_back();
+        
+        // Skip entries superseded by a cheaper push of the same cell
+        if (current.cost != workspace.getCost(current.idx)) {
+            continue;
+        }
+        stats.nodesExpanded++;
+        
+        if (current.idx == goal) {
+            tracePath(grid, workspace, start, goal, path);
+            return true;
+        }
+        
+        int nextCost = current.cost + 1;
+        for (int i = 0; i < 4; i++) {
+            int next = current.idx + grid.neighborOffset(i);
+            if (!grid.isOpen(next)) {
+                continue;
+            }
+            if (!workspace.isVisited(next) || nextCost < workspace.getCost(next)) {
+                workspace.visit(next, current.idx, nextCost);
+                open.push_back({nextCost + heuristic(next), nextCost, next});
+                push_heap(open.begin(), open.end(), openEntryAfter);
+            }
+        }
+    }
+    
+    return false;
+}
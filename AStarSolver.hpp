@@ -0,0 +1,26 @@
+/*
+ * AStarSolver.hpp - A* search strategy (Manhattan heuristic)
+ */
+
+#ifndef ASTARSOLVER_HPP
+#define ASTARSOLVER_HPP
+
+#include "PathSolver.hpp"
+
+class AStarSolver : public PathSolver {
+protected:
+    bool search(const MazeGrid& grid, int start, int goal, SolverWorkspace& workspace,
+                vector<Cell>& path, SolveStats& stats) override;
+    
+public:
+    const char* getName() const override { return "A*"; }
+};
+
+// Heap ordering shared by the best-first solvers: lowest f first, and on
+// equal f the entry with the larger g, which heads straight for the goal
+// instead of fanning out across an open room
+inline bool openEntryAfter(const OpenEntry& a, const OpenEntry& b) {
+    return a.priority > b.priority || (a.priority == b.priority && a.cost < b.cost);
+}
+
+#endif // ASTARSOLVER_HPP
@@ -0,0 +1,38 @@
+/*
+ * BfsSolver.cpp - Breadth-first search strategy implementation
+ */
+
+#include "BfsSolver.hpp"
+
+using namespace std;
+
+bool BfsSolver::search(const MazeGrid& grid, int start, int goal, SolverWorkspace& workspace,
+                       vector<Cell>& path, SolveStats& stats) {
+    workspace.begin(grid.getCellCount());
+    int* queue = workspace.queueData();
+    size_t head = 0, tail = 0;
+    
+    workspace.visit(start, -1);
+    queue[tail++] = start;
+    
+    while (head < tail) {
+        int current = queue[head++];
+        stats.nodesExpanded++;
+        
+        if (current == goal) {
+            tracePath(grid, workspace, start, goal, path);
+            return true;
+        }
+        
+        // No bounds checks needed: the border sentinel is never open
+        for (int i = 0; i < 4; i++) {
+            int next = current + grid.neighborOffset(i);
+            if (grid.isOpen(next) && !workspace.isVisited(next)) {
+                workspace.visit(next, current);
+                queue[tail++] = next;
+            }
+        }
+    }
+    
+    return false;
+}
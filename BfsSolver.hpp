@@ -0,0 +1,19 @@
+/*
+ * BfsSolver.hpp - Breadth-first search strategy
+ */
+
+#ifndef BFSSOLVER_HPP
+#define BFSSOLVER_HPP
+
+#include "PathSolver.hpp"
+
+class BfsSolver : public PathSolver {
+protected:
+    bool search(const MazeGrid& grid, int start, int goal, SolverWorkspace& workspace,
+                vector<Cell>& path, SolveStats& stats) override;
+    
+public:
+    const char* getName() const override { return "BFS"; }
+};
+
+#endif // BFSSOLVER_HPP
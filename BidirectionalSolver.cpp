@@ -0,0 +1,109 @@
+/*
+ * BidirectionalSolver.cpp - Bidirectional breadth-first search implementation
+ */
+
+#include "BidirectionalSolver.hpp"
+
+using namespace std;
+
+namespace {
+    // Both searches share the workspace: the cost slot holds the depth for
+    // the start side and -(depth + 1) for the goal side, and the parent
+    // link points back toward whichever end the cell was reached from
+    inline int encodeDepth(bool fromGoal, int depth) { return fromGoal ? -(depth + 1) : depth; }
+    inline bool isGoalSide(int code) { return code < 0; }
+    inline int decodeDepth(int code) { return code < 0 ? -code - 1 : code; }
+}
+
+bool BidirectionalSolver::search(const MazeGrid& grid, int start, int goal, SolverWorkspace& workspace,
+                                 vector<Cell>& path, SolveStats& stats) {
+    workspace.begin(grid.getCellCount());
+    if (start == goal) {
+        workspace.visit(start, -1, 0);
+        tracePath(grid, workspace, start, goal, path);
+        return true;
+    }
+    
+    // Each cell is queued at most once by either side, so the start side
+    // fills the queue from the front and the goal side from the back
+    int* queue = workspace.queueData();
+    size_t forwardHead = 0, forwardTail = 0;
+    size_t backwardHead = static_cast<size_t>(grid.getCellCount());
+    size_t backwardTail = backwardHead;
+    
+    workspace.visit(start, -1, encodeDepth(false, 0));
+    queue[forwardTail++] = start;
+    workspace.visit(goal, -1, encodeDepth(true, 0));
+    queue[--backwardTail] = goal;
+    
+    int bestLength = -1;
+    int meetForward = -1, meetBackward = -1;
+    
+    while (forwardHead < forwardTail && backwardHead > backwardTail) {
+        bool fromGoal = (backwardHead - backwardTail) < (forwardTail - forwardHead);
+        
+        // Expand exactly one layer of the chosen side
+        size_t layerBegin = fromGoal ? backwardTail : forwardHead;
+        size_t layerEnd = fromGoal ? backwardHead : forwardTail;
+        if (fromGoal) {
+            backwardHead = backwardTail;
+        } else {
+            forwardHead = forwardTail;
+        }
+        
+        for (size_t q = layerBegin; q < layerEnd; q++) {
+            int current = queue[q];
+            int depth = decodeDepth(workspace.getCost(current));
+            stats.nodesExpanded++;
+            
+            for (int i = 0; i < 4; i++) {
+                int next = current + grid.neighborOffset(i);
+                if (!grid.isOpen(next)) {
+                    continue;
+                }
+                if (!workspace.isVisited(next)) {
+                    workspace.visit(next, current, encodeDepth(fromGoal, depth + 1));
+                    if (fromGoal) {
+                        queue[--backwardTail] = next;
+                    } else {
+                        queue[forwardTail++] = next;
+                    }
+                    continue;
+                }
+                
+                // Reached by the other side: a candidate meeting edge
+                int code = workspace.getCost(next);
+                if (isGoalSide(code) != fromGoal) {
+                    int length = depth + 1 + decodeDepth(code);
+                    if (bestLength < 0 || length < bestLength) {
+                        bestLength = length;
+                        meetForward = fromGoal ? next : current;
+                        meetBackward = fromGoal ? current : next;
+                    }
+                }
+            }
+        }
+        
+        if (bestLength >= 0) {
+            break;
+        }
+    }
+    
+    if (bestLength < 0) {
+        return false;
+    }
+    
+    // Start side: walk parents back to the start, filling from the meeting
+    // point down. Goal side: its parents already lead toward the goal.
+    path.resize(bestLength + 1);
+    int step = decodeDepth(workspace.getCost(meetForward));
+    for (int idx = meetForward; idx != -1; idx = workspace.getParent(idx), step--) {
+        path[step] = Cell(grid.rowOf(idx), grid.colOf(idx), step);
+    }
+    step = decodeDepth(workspace.getCost(meetForward)) + 1;
+    for (int idx = meetBackward; idx != -1; idx = workspace.getParent(idx), step++) {
+        path[step] = Cell(grid.rowOf(idx), grid.colOf(idx), step);
+    }
+    
+    return true;
+}
@@ -0,0 +1,31 @@
+/*
+ * BidirectionalSolver.hpp - Bidirectional breadth-first search strategy
+ */
+
+#ifndef BIDIRECTIONALSOLVER_HPP
+#define BIDIRECTIONALSOLVER_HPP
+
+#include "PathSolver.hpp"
+
+// Grows one BFS from the start and one from the goal, always advancing
+// whichever frontier is smaller by a whole layer. The first layer that
+// touches the other search yields the shortest path: every meeting found
+// in that layer is compared and the best one is spliced from both parent
+// chains. When the two searches meet halfway, each has explored roughly
+// the cells within half the path length, instead of one search exploring
+// everything within the full length.
+//
+// Only the length is guaranteed to match BFS. Where several shortest paths
+// exist, the meeting cell and the goal-side parent links choose among them
+// differently from BfsSolver, so the cells may differ. Use BFS or
+// PARALLEL_BFS when the exact route matters, e.g. for replays.
+class BidirectionalSolver : public PathSolver {
+protected:
+    bool search(const MazeGrid& grid, int start, int goal, SolverWorkspace& workspace,
+                vector<Cell>& path, SolveStats& stats) override;
+    
+public:
+    const char* getName() const override { return "Bidirectional BFS"; }
+};
+
+#endif // BIDIRECTIONALSOLVER_HPP
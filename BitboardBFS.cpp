@@ -0,0 +1,149 @@
+/*
+ * BitboardBFS.cpp - Bit-parallel breadth-first search implementation
+ */
+
+#include "BitboardBFS.hpp"
+#include "Common.hpp"
+#include <algorithm>
+
+using namespace std;
+
+BitboardBFS::BitboardBFS()
+    : rows(0),
+      cols(0),
+      words(0) {
+}
+
+void BitboardBFS::build(const MazeGrid& grid) {
+    rows = grid.getRows();
+    cols = grid.getCols();
+    // Keep at least one unused bit at the top of every row so the flat
+    // expansion loop can shift across row boundaries without masking
+    words = cols / 64 + 1;
+    
+    size_t total = static_cast<size_t>(rows + 2) * words;
+    open.assign(total, 0);
+    visited.assign(total, 0);
+    frontier.assign(total, 0);
+    next.assign(total, 0);
+    
+    for (int r = 0; r < rows; r++) {
+        uint64_t* bits = rowOf(open, r);
+        for (int c = 0; c < cols; c++) {
+            if (grid.isOpen(grid.index(r, c))) {
+                bits[c >> 6] |= uint64_t(1) << (c & 63);
+            }
+        }
+    }
+}
+
+optional<int> BitboardBFS::search(int startRow, int startCol, int targetRow, int targetCol, bool keepLayers) {
+    if (startRow < 0 || startRow >= rows || startCol < 0 || startCol >= cols ||
+        targetRow < 0 || targetRow >= rows || targetCol < 0 || targetCol >= cols) {
+        return nullopt;
+    }
+    if (!testBit(rowOf(open, startRow), startCol) || !testBit(rowOf(open, targetRow), targetCol)) {
+        return nullopt;
+    }
+    
+    fill(visited.begin(), visited.end(), 0);
+    fill(frontier.begin(), frontier.end(), 0);
+    layerBits.clear();
+    layers.clear();
+    
+    rowOf(frontier, startRow)[startCol >> 6] |= uint64_t(1) << (startCol & 63);
+    rowOf(visited, startRow)[startCol >> 6] |= uint64_t(1) << (startCol & 63);
+    int firstRow = startRow, lastRow = startRow;
+    
+    for (int layer = 0; ; layer++) {
+        if (keepLayers) {
+            LayerSpan span = {firstRow, lastRow, layerBits.size()};
+            layerBits.insert(layerBits.end(), rowOf(frontier, firstRow), rowOf(frontier, lastRow + 1));
+            layers.push_back(span);
+        }
+        
+        if (testBit(rowOf(frontier, targetRow), targetCol)) {
+            return layer;
+        }
+        
+        // Expand the frontier by one step over the whole row span as one flat
+        // run of words. Each row has at least one spare high bit (see build),
+        // so bits carried across a row boundary always land on a closed cell.
+        int expandFirst = max(0, firstRow - 1);
+        int expandLast = min(rows - 1, lastRow + 1);
+        const uint64_t* here = rowOf(frontier, 0);
+        const uint64_t* openBits = rowOf(open, 0);
+        uint64_t* visitedBits = rowOf(visited, 0);
+        uint64_t* nextBits = rowOf(next, 0);
+        size_t begin = static_cast<size_t>(expandFirst) * words;
+        size_t end = static_cast<size_t>(expandLast + 1) * words;
+        
+        for (size_t i = begin; i < end; i++) {
+            uint64_t east = (here[i] << 1) | (here[i - 1] >> 63);
+            uint64_t west = (here[i] >> 1) | (here[i + 1] << 63);
+            uint64_t reached = (east | west | here[i - words] | here[i + words]) & openBits[i] & ~visitedBits[i];
+            nextBits[i] = reached;
+            visitedBits[i] |= reached;
+        }
+        
+        // Trim the new span to the rows that actually gained cells
+        size_t first = begin, last = end;
+        while (first < end && nextBits[first] == 0) {
+            first++;
+        }
+        if (first == end) {
+            return nullopt;  // Frontier died out before reaching the target
+        }
+        while (nextBits[last - 1] == 0) {
+            last--;
+        }
+        int nextFirst = static_cast<int>(first / words);
+        int nextLast = static_cast<int>((last - 1) / words);
+        
+        // Swap buffers, then clear the old frontier rows so the spare
+        // buffer is all zeroes again for the next expansion
+        frontier.swap(next);
+        for (int r = firstRow; r <= lastRow; r++) {
+            fill_n(rowOf(next, r), words, 0);
+        }
+        firstRow = nextFirst;
+        lastRow = nextLast;
+    }
+}
+
+optional<int> BitboardBFS::distance(int startRow, int startCol, int targetRow, int targetCol) {
+    return search(startRow, startCol, targetRow, targetCol, false);
+}
+
+optional<vector<Cell>> BitboardBFS::findPath(int startRow, int startCol, int targetRow, int targetCol) {
+    optional<int> length = search(startRow, startCol, targetRow, targetCol, true);
+    if (!length.has_value()) {
+        return nullopt;
+    }
+    
+    // Walk back from the target: the predecessor on layer k - 1 is any
+    // neighbour whose bit is set in that layer's stored frontier
+    vector<Cell> path(length.value() + 1);
+    int r = targetRow, c = targetCol;
+    path[length.value()] = Cell(r, c, length.value());
+    
+    for (int k = length.value() - 1; k >= 0; k--) {
+        const LayerSpan& span = layers[k];
+        for (int i = 0; i < 4; i++) {
+            int nr = r + dx[i];
+            int nc = c + dy[i];
+            if (nr < span.firstRow || nr > span.lastRow || nc < 0 || nc >= cols) {
+                continue;
+            }
+            const uint64_t* bits = layerBits.data() + span.offset + static_cast<size_t>(nr - span.firstRow) * words;
+            if (testBit(bits, nc)) {
+                r = nr;
+                c = nc;
+                break;
+            }
+        }
+        path[k] = Cell(r, c, k);
+    }
+    
+    return path;
+}
@@ -0,0 +1,60 @@
+/*
+ * BitboardBFS.hpp - Bit-parallel breadth-first search over packed rows
+ */
+
+#ifndef BITBOARDBFS_HPP
+#define BITBOARDBFS_HPP
+
+#include "Common.hpp"
+#include "MazeGrid.hpp"
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+using namespace std;
+
+// Open cells are stored as one bit per cell, 64 columns per word. A BFS
+// layer is expanded for whole words at a time: shifting a row left/right
+// moves the frontier east/west, and OR-ing the rows above and below moves it
+// north/south. Only the rows the frontier currently spans are touched.
+//
+// Works best on open or loopy mazes where layers are wide; on long
+// single-corridor mazes each layer is tiny and the per-cell queue BFS is
+// just as fast.
+class BitboardBFS {
+private:
+    // Rows of one stored layer, used to walk a path back from the target
+    struct LayerSpan {
+        int firstRow, lastRow;
+        size_t offset;
+    };
+    
+    int rows, cols;
+    int words;                      // 64-bit words per row, top bit always unused
+    vector<uint64_t> open;          // (rows + 2) x words, first and last row stay empty
+    vector<uint64_t> visited;
+    vector<uint64_t> frontier;
+    vector<uint64_t> next;
+    vector<uint64_t> layerBits;     // Frontier bits of every layer (findPath only)
+    vector<LayerSpan> layers;
+    
+    uint64_t* rowOf(vector<uint64_t>& bits, int row) { return bits.data() + static_cast<size_t>(row + 1) * words; }
+    bool testBit(const uint64_t* row, int col) const { return (row[col >> 6] >> (col & 63)) & 1; }
+    
+    // Shared search loop; returns the layer the target was reached on
+    optional<int> search(int startRow, int startCol, int targetRow, int targetCol, bool keepLayers);
+    
+public:
+    BitboardBFS();
+    
+    // Pack the open cells of a grid. Must be called again if walls change.
+    void build(const MazeGrid& grid);
+    
+    // Number of steps between two cells, without reconstructing the path
+    optional<int> distance(int startRow, int startCol, int targetRow, int targetCol);
+    
+    // Full shortest path, rebuilt from the stored per-layer frontiers
+    optional<vector<Cell>> findPath(int startRow, int startCol, int targetRow, int targetCol);
+};
+
+#endif // BITBOARDBFS_HPP
@@ -0,0 +1,46 @@
+/*
+ * BucketQueue.cpp - Monotone bucket priority queue implementation
+ */
+
+#include "BucketQueue.hpp"
+
+using namespace std;
+
+BucketQueue::BucketQueue()
+    : currentKey(0),
+      current(0),
+      count(0) {
+}
+
+void BucketQueue::reset(int maxStep) {
+    size_t needed = static_cast<size_t>(maxStep) + 1;
+    if (buckets.size() < needed) {
+        buckets.resize(needed);
+    }
+    // clear() keeps each bucket's capacity for the next search
+    for (auto& bucket : buckets) {
+        bucket.clear();
+    }
+    currentKey = 0;
+    current = 0;
+    count = 0;
+}
+
+void BucketQueue::push(uint64_t entry, int key) {
+    size_t slot = (current + static_cast<size_t>(key - currentKey)) % buckets.size();
+    buckets[slot].push_back(entry);
+    count++;
+}
+
+uint64_t BucketQueue::pop(int& key) {
+    while (buckets[current].empty()) {
+        current = (current + 1) % buckets.size();
+        currentKey++;
+    }
+    
+    uint64_t entry = buckets[current].back();
+    buckets[current].pop_back();
+    count--;
+    key = currentKey;
+    return entry;
+}
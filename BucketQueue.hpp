@@ -0,0 +1,42 @@
+/*
+ * BucketQueue.hpp - Monotone bucket priority queue for small integer costs
+ */
+
+#ifndef BUCKETQUEUE_HPP
+#define BUCKETQUEUE_HPP
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Dial's bucket queue. Keys never decrease and every push is at most
+// maxStep above the last popped key, so maxStep + 1 circular buckets cover
+// every live key: push and pop are O(1) instead of O(log n) for a binary
+// heap. Decrease-key is done lazily by pushing again; callers skip stale
+// entries when they pop them. Bucket storage is kept between searches.
+// Entries are 64-bit so callers can pack extra data (e.g. a parent link)
+// next to a cell or state index.
+class BucketQueue {
+private:
+    vector<vector<uint64_t>> buckets;
+    int currentKey;      // Key of the bucket pop() is draining
+    size_t current;      // currentKey % buckets.size()
+    size_t count;        // Entries still queued
+    
+public:
+    BucketQueue();
+    
+    // Empty the queue for keys in steps of at most maxStep, starting at 0
+    void reset(int maxStep);
+    
+    bool empty() const { return count == 0; }
+    
+    // key must lie in [last popped key, last popped key + maxStep]
+    void push(uint64_t entry, int key);
+    
+    // Remove an entry with the smallest key; 'key' receives that key
+    uint64_t pop(int& key);
+};
+
+#endif // BUCKETQUEUE_HPP
@@ -0,0 +1,55 @@
+/*
+ * Camera.cpp - Scrolling maze view implementation
+ */
+
+#include "Camera.hpp"
+#include "Common.hpp"
+#include <algorithm>
+
+using namespace std;
+using namespace sf;
+
+Camera::Camera()
+    : zoom(1.f) {
+}
+
+void Camera::setArea(Vector2u window, Vector2f area) {
+    windowSize = Vector2f(static_cast<float>(window.x), static_cast<float>(window.y));
+    areaSize = area;
+    
+    // The map area as a fraction of the window
+    view.setViewport(FloatRect(Vector2f(0.f, 0.f), Vector2f(area.x / windowSize.x, area.y / windowSize.y)));
+    view.setSize(areaSize * zoom);
+}
+
+void Camera::zoomBy(float factor) {
+    zoom = max(MIN_ZOOM, min(MAX_ZOOM, zoom * factor));
+    view.setSize(areaSize * zoom);
+}
+
+void Camera::follow(Vector2f focus, Vector2f worldSize) {
+    Vector2f size = view.getSize();
+    Vector2f center;
+    
+    // Pinned when the maze and its leading padding fit, else follow and clamp
+    if (worldSize.x - WINDOW_PADDING <= size.x) {
+        center.x = size.x / 2.f;
+    } else {
+        center.x = max(size.x / 2.f, min(worldSize.x - size.x / 2.f, focus.x));
+    }
+    if (worldSize.y - WINDOW_PADDING <= size.y) {
+        center.y = size.y / 2.f;
+    } else {
+        center.y = max(size.y / 2.f, min(worldSize.y - size.y / 2.f, focus.y));
+    }
+    
+    // Whole pixels at 1:1 so cell edges stay crisp
+    if (zoom == 1.f) {
+        center = Vector2f(static_cast<float>(static_cast<int>(center.x)), static_cast<float>(static_cast<int>(center.y)));
+    }
+    view.setCenter(center);
+}
+
+FloatRect Camera::getVisibleArea() const {
+    return FloatRect(view.getCenter() - view.getSize() / 2.f, view.getSize());
+}
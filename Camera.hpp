@@ -0,0 +1,49 @@
+/*
+ * Camera.hpp - Scrolling, zoomable view onto the maze
+ */
+
+#ifndef CAMERA_HPP
+#define CAMERA_HPP
+
+#include <SFML/Graphics.hpp>
+
+using namespace std;
+using namespace sf;
+
+// Wraps the sf::View the maze is drawn through. The view fills the map
+// area at the top of the window (everything above the HUD) and shows
+// 'zoom' world pixels per screen pixel. Along an axis where the maze fits
+// in the view it stays pinned the way the fixed layout had it, with the
+// world origin in the corner. Along an axis where it doesn't fit, the
+// view centres on the followed point and is clamped to the maze edges.
+class Camera {
+private:
+    View view;
+    Vector2f areaSize;      // Map area in screen pixels
+    Vector2f windowSize;
+    float zoom;
+    
+public:
+    static constexpr float MIN_ZOOM = 0.5f;   // Two screen pixels per world pixel
+    static constexpr float MAX_ZOOM = 64.f;   // Cells under a pixel; drawn from the overview
+    
+    Camera();
+    
+    // The map area is the top 'area' pixels of a 'window'-sized window
+    void setArea(Vector2u window, Vector2f area);
+    
+    // Multiply the zoom by 'factor' (> 1 zooms out), within the limits
+    void zoomBy(float factor);
+    float getZoom() const { return zoom; }
+    
+    // Centre on 'focus', both in world pixels; 'worldSize' is the extent
+    // of the maze including its padding
+    void follow(Vector2f focus, Vector2f worldSize);
+    
+    const View& getView() const { return view; }
+    
+    // World rectangle currently on screen
+    FloatRect getVisibleArea() const;
+};
+
+#endif // CAMERA_HPP
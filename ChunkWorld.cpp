@@ -0,0 +1,197 @@
+/*
+ * ChunkWorld.cpp - Chunked endless maze implementation
+ */
+
+#include "ChunkWorld.hpp"
+#include "MazeGenerator.hpp"
+#include "Random.hpp"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+    const int CHUNK_ROOMS = ChunkWorld::CHUNK_SIZE / 2;
+    
+    // A few loops so the world isn't one long tree of dead ends
+    const float CHUNK_LOOP_DENSITY = 0.1f;
+    
+    // Mixed into a chunk's seed to pick its door positions
+    const uint64_t TOP_DOOR = 0x3C6EF372FE94F82BULL;
+    const uint64_t LEFT_DOOR = 0xA54FF53A5F1D36F1ULL;
+    
+    inline int64_t floorDiv(int64_t value, int64_t divisor) {
+        return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+    }
+}
+
+ChunkWorld::ChunkWorld(size_t maxChunks, ThreadPool* threadPool)
+    : worldSeed(1),
+      capacity(max<size_t>(maxChunks, 9)),
+      builtChunks(0),
+      pool(threadPool),
+      inFlight(0),
+      generation(0) {
+}
+
+ChunkWorld::~ChunkWorld() {
+    // Background builds write into this object
+    unique_lock<mutex> guard(lock);
+    idle.wait(guard, [this] { return inFlight == 0; });
+}
+
+uint64_t ChunkWorld::keyOf(int64_t chunkRow, int64_t chunkCol) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(chunkRow)) << 32) |
+           static_cast<uint32_t>(chunkCol);
+}
+
+void ChunkWorld::build(uint64_t seed, int64_t chunkRow, int64_t chunkCol, vector<char>& cells) {
+    uint64_t chunkSeed = mixSeed(seed ^ mixSeed(keyOf(chunkRow, chunkCol)));
+    
+    // One extra row and column so the generator's far border wall can be
+    // dropped; the neighbours own those lines
+    thread_local MazeGenerator generator;
+    thread_local MazeGrid grid;
+    GeneratorConfig config(CHUNK_SIZE + 1, CHUNK_SIZE + 1, GeneratorAlgorithm::BACKTRACKER, chunkSeed);
+    config.loopDensity = CHUNK_LOOP_DENSITY;
+    generator.generate(config, grid);
+    
+    cells.resize(static_cast<size_t>(CHUNK_SIZE) * CHUNK_SIZE);
+    for (int row = 0; row < CHUNK_SIZE; row++) {
+        for (int col = 0; col < CHUNK_SIZE; col++) {
+            cells[row * CHUNK_SIZE + col] = grid.at(row, col);
+        }
+    }
+    
+    // Doors through the owned top and left walls, each onto a room row/column
+    int topRoom = static_cast<int>(mixSeed(chunkSeed ^ TOP_DOOR) % CHUNK_ROOMS);
+    int leftRoom = static_cast<int>(mixSeed(chunkSeed ^ LEFT_DOOR) % CHUNK_ROOMS);
+    cells[2 * topRoom + 1] = '.';
+    cells[(2 * leftRoom + 1) * CHUNK_SIZE] = '.';
+}
+
+ChunkWorld::Chunk& ChunkWorld::insert(Chunk&& chunk) {
+    uint64_t key = keyOf(chunk.chunkRow, chunk.chunkCol);
+    chunks.push_front(move(chunk));
+    lookup[key] = chunks.begin();
+    builtChunks++;
+    
+    // Evict from the cold end
+    while (chunks.size() > capacity) {
+        const Chunk& oldest = chunks.back();
+        lookup.erase(keyOf(oldest.chunkRow, oldest.chunkCol));
+        chunks.pop_back();
+    }
+    return chunks.front();
+}
+
+void ChunkWorld::absorbFinished() {
+    vector<Chunk> ready;
+    {
+        lock_guard<mutex> guard(lock);
+        ready.swap(finished);
+    }
+    for (Chunk& chunk : ready) {
+        // Already built in place if it was read before this one landed
+        if (lookup.find(keyOf(chunk.chunkRow, chunk.chunkCol)) == lookup.end()) {
+            insert(move(chunk));
+        }
+    }
+}
+
+ChunkWorld::Chunk& ChunkWorld::fetch(int64_t chunkRow, int64_t chunkCol) {
+    uint64_t key = keyOf(chunkRow, chunkCol);
+    auto found = lookup.find(key);
+    if (found == lookup.end()) {
+        absorbFinished();
+        found = lookup.find(key);
+    }
+    if (found != lookup.end()) {
+        // Touch: move to the front of the LRU list
+        if (found->second != chunks.begin()) {
+            chunks.splice(chunks.begin(), chunks, found->second);
+        }
+        return chunks.front();
+    }
+    
+    Chunk chunk;
+    chunk.chunkRow = chunkRow;
+    chunk.chunkCol = chunkCol;
+    build(worldSeed, chunkRow, chunkCol, chunk.cells);
+    return insert(move(chunk));
+}
+
+bool ChunkWorld::collectFinished() {
+    long long before = builtChunks;
+    absorbFinished();
+    return builtChunks != before;
+}
+
+bool ChunkWorld::isBuilding() const {
+    lock_guard<mutex> guard(lock);
+    return inFlight > 0 || !finished.empty();
+}
+
+void ChunkWorld::reset(uint64_t seed) {
+    worldSeed = seed;
+    chunks.clear();
+    lookup.clear();
+    builtChunks = 0;
+    
+    lock_guard<mutex> guard(lock);
+    finished.clear();
+    pending.clear();
+    generation++;
+}
+
+char ChunkWorld::at(int64_t row, int64_t col) {
+    int64_t chunkRow = floorDiv(row, CHUNK_SIZE);
+    int64_t chunkCol = floorDiv(col, CHUNK_SIZE);
+    const Chunk& chunk = fetch(chunkRow, chunkCol);
+    int localRow = static_cast<int>(row - chunkRow * CHUNK_SIZE);
+    int localCol = static_cast<int>(col - chunkCol * CHUNK_SIZE);
+    return chunk.cells[localRow * CHUNK_SIZE + localCol];
+}
+
+void ChunkWorld::prefetch(int64_t row, int64_t col, int radius) {
+    absorbFinished();
+    if (!pool) {
+        pool = &ThreadPool::shared();
+    }
+    
+    int64_t centerRow = floorDiv(row, CHUNK_SIZE);
+    int64_t centerCol = floorDiv(col, CHUNK_SIZE);
+    for (int64_t chunkRow = centerRow - radius; chunkRow <= centerRow + radius; chunkRow++) {
+        for (int64_t chunkCol = centerCol - radius; chunkCol <= centerCol + radius; chunkCol++) {
+            uint64_t key = keyOf(chunkRow, chunkCol);
+            auto found = lookup.find(key);
+            if (found != lookup.end()) {
+                // Keep the neighbourhood warm so eviction takes far chunks first
+                chunks.splice(chunks.begin(), chunks, found->second);
+                continue;
+            }
+            
+            lock_guard<mutex> guard(lock);
+            if (!pending.insert(key).second) {
+                continue;
+            }
+            inFlight++;
+            uint64_t seed = worldSeed;
+            int queuedGeneration = generation;
+            pool->submit([this, seed, chunkRow, chunkCol, key, queuedGeneration] {
+                Chunk chunk;
+                chunk.chunkRow = chunkRow;
+                chunk.chunkCol = chunkCol;
+                build(seed, chunkRow, chunkCol, chunk.cells);
+                
+                lock_guard<mutex> done(lock);
+                if (queuedGeneration == generation) {
+                    finished.push_back(move(chunk));
+                    pending.erase(key);
+                }
+                if (--inFlight == 0) {
+                    idle.notify_all();
+                }
+            });
+        }
+    }
+}
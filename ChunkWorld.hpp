@@ -0,0 +1,93 @@
+/*
+ * ChunkWorld.hpp - Unbounded maze world generated chunk by chunk
+ */
+
+#ifndef CHUNKWORLD_HPP
+#define CHUNKWORLD_HPP
+
+#include "ThreadPool.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace std;
+
+// An endless maze addressed by 64-bit (row, col), about 2^36 cells each
+// way. The plane is cut into CHUNK_SIZE x CHUNK_SIZE chunks; each is a
+// perfect maze (plus a few loops) carved from a seed derived from the world
+// seed and the chunk's coordinates, so a chunk comes out the same whenever
+// and on whichever thread it is built. A chunk owns its top wall row and left wall column
+// and opens one door in each, at a room picked by hashing that edge; the
+// chunks above and to the left own nothing on the shared side, so borders
+// always agree and every chunk connects to all four neighbours.
+//
+// Only 'capacity' chunks are kept, evicted least recently used, so memory
+// is constant however far the player goes. prefetch() builds the chunks
+// around a position on the thread pool ahead of time; a chunk that is
+// read before its background build lands is simply built in place.
+class ChunkWorld {
+public:
+    static const int CHUNK_SIZE = 32;   // Cells per side, even so rooms stay on odd coordinates
+    
+private:
+    struct Chunk {
+        int64_t chunkRow, chunkCol;
+        vector<char> cells;             // CHUNK_SIZE x CHUNK_SIZE, row-major
+    };
+    
+    uint64_t worldSeed;
+    size_t capacity;
+    list<Chunk> chunks;                 // Most recently used first
+    unordered_map<uint64_t, list<Chunk>::iterator> lookup;
+    long long builtChunks;              // Chunks loaded since reset(), evicted ones included
+    ThreadPool* pool;
+    
+    // Background builds hand finished chunks over through this
+    mutable mutex lock;
+    condition_variable idle;
+    vector<Chunk> finished;
+    unordered_set<uint64_t> pending;    // Keys queued or being built
+    int inFlight;
+    int generation;                     // Bumped by reset() to drop stale builds
+    
+    static uint64_t keyOf(int64_t chunkRow, int64_t chunkCol);
+    static void build(uint64_t seed, int64_t chunkRow, int64_t chunkCol, vector<char>& cells);
+    Chunk& fetch(int64_t chunkRow, int64_t chunkCol);
+    Chunk& insert(Chunk&& chunk);
+    void absorbFinished();
+    
+public:
+    // nullptr = ThreadPool::shared(), looked up on the first prefetch
+    explicit ChunkWorld(size_t maxChunks = 64, ThreadPool* threadPool = nullptr);
+    ~ChunkWorld();
+    
+    ChunkWorld(const ChunkWorld&) = delete;
+    ChunkWorld& operator=(const ChunkWorld&) = delete;
+    
+    // Forget every chunk and start a new world
+    void reset(uint64_t seed);
+    
+    // Cell at (row, col), generating its chunk if needed
+    char at(int64_t row, int64_t col);
+    
+    // Queue background builds of every chunk within 'radius' chunks of (row, col)
+    void prefetch(int64_t row, int64_t col, int radius);
+    
+    // Take in chunks whose background build has finished (at() and
+    // prefetch() do this too); true if any arrived
+    bool collectFinished();
+    
+    // Background builds queued, running, or finished but not collected.
+    // Nothing wakes the UI when one lands, so callers poll while this holds.
+    bool isBuilding() const;
+    
+    size_t getLoadedChunks() const { return chunks.size(); }
+    size_t getCapacity() const { return capacity; }
+    long long getBuiltChunks() const { return builtChunks; }
+};
+
+#endif // CHUNKWORLD_HPP
@@ -15,6 +15,31 @@ using namespace sf;
 // Constants for maze representation
 const int CELL_SIZE = 40;        // Size of each cell in pixels
 const int WINDOW_PADDING = 50;   // Padding around the maze
+const int HUD_HEIGHT = 180;      // Text panel below the map view
+
+// Level number of the endless chunked world (after the three regular levels)
+const int ENDLESS_LEVEL = 4;
+
+// Movement costs for entering a cell ('~' is mud)
+const int PATH_COST = 1;
+const int MUD_COST = 3;
+const int MAX_CELL_COST = MUD_COST;
+const int MOVE_DELAY_MS = 50;    // Input delay after entering a cost-1 cell
+
+inline int cellCost(char cell) {
+    return cell == '~' ? MUD_COST : PATH_COST;
+}
+
+// Keys 'q'..'x' open the doors 'Q'..'X' of the same letter
+const int MAX_KEY_TYPES = 8;
+
+inline int keyType(char cell) {
+    return (cell >= 'q' && cell < 'q' + MAX_KEY_TYPES) ? cell - 'q' : -1;
+}
+
+inline int doorType(char cell) {
+    return (cell >= 'Q' && cell < 'Q' + MAX_KEY_TYPES) ? cell - 'Q' : -1;
+}
 
 // Direction vectors for movement (up, down, left, right)
 const int dx[] = {-1, 1, 0, 0};
@@ -46,6 +71,23 @@ namespace GameColors {
     const Color BackgroundColor(30, 30, 40);  // Dark background
     const Color MudColor(101, 67, 33);        // Brown color for mud
     const Color ObstacleColor(180, 50, 50);   // Red color for obstacles
+    const Color KeyColor(240, 200, 40);       // Gold color for keys
+    const Color CheckpointColor(70, 190, 230); // Cyan color for checkpoints
+}
+
+// Fill colour of a cell's square; keys and checkpoints are drawn on top of it
+inline Color cellColor(char cell) {
+    if (cell == '#') {
+        return GameColors::WallColor;
+    } else if (cell == '~') {
+        return GameColors::MudColor;
+    } else if (doorType(cell) >= 0) {
+        return GameColors::ObstacleColor;
+    } else if (cell == 'G') {
+        return GameColors::GoalColor;
+    }
+    // Path, and the path under keys and checkpoints
+    return GameColors::PathColor;
 }
 
 #endif // COMMON_HPP
@@ -0,0 +1,117 @@
+/*
+ * DifficultySearch.cpp - Targeted level generation implementation
+ */
+
+#include "DifficultySearch.hpp"
+#include "Random.hpp"
+#include <SFML/System.hpp>
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+using namespace sf;
+
+namespace {
+    // Candidates per slot in one parallel batch
+    const int BATCH_PER_SLOT = 4;
+    
+    // Scores an unsolvable candidate below any solvable one
+    const float UNREACHABLE_MISS = 1e6f;
+    
+    // Distance of 'value' outside [low, high], relative to the bound it crosses
+    inline float outside(float value, float low, float high) {
+        if (value < low) {
+            return (low - value) / max(low, 1e-6f);
+        }
+        if (value > high) {
+            return (value - high) / max(high, 1e-6f);
+        }
+        return 0.f;
+    }
+}
+
+DifficultySearch::DifficultySearch(ThreadPool* threadPool)
+    : pool(threadPool) {
+}
+
+uint64_t DifficultySearch::candidateSeed(uint64_t baseSeed, int index) {
+    return index == 0 ? baseSeed : mixSeed(baseSeed ^ mixSeed(static_cast<uint64_t>(index)));
+}
+
+float DifficultySearch::miss(const DifficultyTarget& target, const MazeMetrics& metrics, int manhattan) {
+    if (metrics.solutionLength < 0) {
+        return UNREACHABLE_MISS;
+    }
+    float detour = static_cast<float>(metrics.solutionLength) / max(manhattan, 1);
+    float deadEndRatio = metrics.openCells > 0 ? static_cast<float>(metrics.deadEnds) / metrics.openCells : 0.f;
+    return outside(detour, target.minDetour, target.maxDetour) +
+           outside(deadEndRatio, target.minDeadEndRatio, target.maxDeadEndRatio);
+}
+
+DifficultyResult DifficultySearch::search(const GeneratorConfig& config, const DifficultyTarget& target,
+                                          MazeGrid& grid) {
+    if (!pool) {
+        pool = &ThreadPool::shared();
+    }
+    if (workers.empty()) {
+        for (int i = 0; i < pool->size(); i++) {
+            workers.push_back(make_unique<Worker>());
+        }
+    }
+    
+    int goalRow = config.rows - 2;
+    int goalCol = config.cols - 2;
+    int manhattan = abs(goalRow - 1) + abs(goalCol - 1);
+    
+    // Tiled generation runs on the pool itself, so it can't be nested in a batch
+    bool serial = config.algorithm == GeneratorAlgorithm::TILED || pool->size() == 1;
+    int batch = serial ? 1 : pool->size() * BATCH_PER_SLOT;
+    grids.resize(batch);
+    results.resize(batch);
+    
+    auto evaluate = [&](int index, int slot, int first) {
+        Worker& worker = *workers[slot];
+        GeneratorConfig candidate = config;
+        candidate.seed = candidateSeed(config.seed, first + index);
+        MazeGrid& candidateGrid = grids[index];
+        worker.generator.generate(candidate, candidateGrid);
+        candidateGrid.at(1, 1) = '.';
+        candidateGrid.at(goalRow, goalCol) = '.';
+        worker.analyzer.measure(candidateGrid, 1, 1, goalRow, goalCol, results[index]);
+    };
+    
+    DifficultyResult result;
+    result.seed = config.seed;
+    result.candidates = 0;
+    result.matched = false;
+    float bestMiss = 0.f;
+    
+    Clock timer;
+    for (int first = 0; ; first += batch) {
+        if (serial) {
+            evaluate(0, 0, first);
+        } else {
+            pool->parallelFor(batch, [&](int index, int slot) { evaluate(index, slot, first); });
+        }
+        result.candidates += batch;
+        
+        // Scan in seed order so the lowest-numbered match wins; the closest
+        // miss so far stays in 'grid' as the fallback
+        for (int index = 0; index < batch; index++) {
+            float candidateMiss = miss(target, results[index], manhattan);
+            if (first + index == 0 || candidateMiss < bestMiss) {
+                bestMiss = candidateMiss;
+                result.seed = candidateSeed(config.seed, first + index);
+                result.metrics = results[index];
+                swap(grid, grids[index]);
+            }
+            if (candidateMiss == 0.f) {
+                result.matched = true;
+                return result;
+            }
+        }
+        if (timer.getElapsedTime().asMilliseconds() >= target.timeBudgetMs) {
+            return result;
+        }
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * DifficultySearch.hpp - Generate candidate mazes until one hits a target difficulty
+ */
+
+#ifndef DIFFICULTYSEARCH_HPP
+#define DIFFICULTYSEARCH_HPP
+
+#include "MazeGenerator.hpp"
+#include "MazeMetrics.hpp"
+#include "ThreadPool.hpp"
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+// Bounds a generated level has to fall within. Solution length is taken
+// relative to the Manhattan distance between start and goal ("detour"),
+// so one target works across level sizes. The default accepts anything.
+struct DifficultyTarget {
+    float minDetour, maxDetour;              // Solution steps / Manhattan distance start -> goal
+    float minDeadEndRatio, maxDeadEndRatio;  // Dead ends per open cell
+    int timeBudgetMs;                        // Then settle for the closest candidate
+    
+    DifficultyTarget()
+        : minDetour(0.f), maxDetour(1e9f), minDeadEndRatio(0.f), maxDeadEndRatio(1.f),
+          timeBudgetMs(50) {}
+    
+    bool operator==(const DifficultyTarget& other) const {
+        return minDetour == other.minDetour && maxDetour == other.maxDetour &&
+               minDeadEndRatio == other.minDeadEndRatio && maxDeadEndRatio == other.maxDeadEndRatio &&
+               timeBudgetMs == other.timeBudgetMs;
+    }
+};
+
+// Outcome of a search
+struct DifficultyResult {
+    uint64_t seed;         // Generating this seed reproduces the chosen maze
+    MazeMetrics metrics;
+    int candidates;        // Mazes generated and measured
+    bool matched;          // false = budget ran out, closest candidate kept
+};
+
+// Generates candidates from seeds derived from a base seed, a batch at a
+// time across the thread pool (one generator, grid and analyzer per slot),
+// and keeps the lowest-numbered candidate inside the target. Candidate 0 is
+// the base seed itself, so searching again from a seed that matched gives
+// the same maze back at once, and the result does not depend on the thread
+// count unless the budget runs out. TILED configurations already use the
+// pool to generate, so their candidates are tried one at a time.
+//
+// Start and goal are the generated level's corners, (1, 1) and
+// (rows - 2, cols - 2); both are opened in every candidate.
+class DifficultySearch {
+private:
+    struct Worker {
+        MazeGenerator generator;
+        MazeMetricsAnalyzer analyzer;
+    };
+    
+    ThreadPool* pool;
+    vector<unique_ptr<Worker>> workers;   // One per pool slot
+    vector<MazeGrid> grids;               // One per candidate in a batch
+    vector<MazeMetrics> results;
+    
+public:
+    // nullptr = ThreadPool::shared(), looked up on the first search
+    explicit DifficultySearch(ThreadPool* threadPool = nullptr);
+    
+    // Fill 'grid' with the first candidate of 'config' (config.seed is the
+    // base and must be non-zero) that meets 'target'
+    DifficultyResult search(const GeneratorConfig& config, const DifficultyTarget& target, MazeGrid& grid);
+    
+    // Seed of candidate 'index' searched from 'baseSeed'
+    static uint64_t candidateSeed(uint64_t baseSeed, int index);
+    
+    // How far 'metrics' falls outside 'target', 0 when inside
+    static float miss(const DifficultyTarget& target, const MazeMetrics& metrics, int manhattan);
+};
+
+#endif // DIFFICULTYSEARCH_HPP
@@ -0,0 +1,47 @@
+/*
+ * DijkstraSolver.cpp - Terrain-cost Dijkstra strategy implementation
+ */
+
+#include "DijkstraSolver.hpp"
+
+using namespace std;
+
+bool DijkstraSolver::search(const MazeGrid& grid, int start, int goal, SolverWorkspace& workspace,
+                            vector<Cell>& path, SolveStats& stats) {
+    workspace.begin(grid.getCellCount());
+    BucketQueue& queue = workspace.bucketQueue();
+    queue.reset(MAX_CELL_COST);
+    
+    workspace.visit(start, -1, 0);
+    queue.push(start, 0);
+    
+    while (!queue.empty()) {
+        int cost;
+        int current = static_cast<int>(queue.pop(cost));
+        
+        // Skip entries superseded by a cheaper push of the same cell
+        if (cost != workspace.getCost(current)) {
+            continue;
+        }
+        stats.nodesExpanded++;
+        
+        if (current == goal) {
+            tracePath(grid, workspace, start, goal, path);
+            return true;
+        }
+        
+        for (int i = 0; i < 4; i++) {
+            int next = current + grid.neighborOffset(i);
+            if (!grid.isOpen(next)) {
+                continue;
+            }
+            int nextCost = cost + grid.cost(next);
+            if (!workspace.isVisited(next) || nextCost < workspace.getCost(next)) {
+                workspace.visit(next, current, nextCost);
+                queue.push(next, nextCost);
+            }
+        }
+    }
+    
+    return false;
+}
@@ -0,0 +1,22 @@
+/*
+ * DijkstraSolver.hpp - Terrain-cost Dijkstra strategy
+ */
+
+#ifndef DIJKSTRASOLVER_HPP
+#define DIJKSTRASOLVER_HPP
+
+#include "PathSolver.hpp"
+
+// Cheapest path where entering a cell costs cellCost() (mud is dearer than
+// floor). Cell costs are small integers, so the frontier lives in the
+// workspace's bucket queue rather than a binary heap.
+class DijkstraSolver : public PathSolver {
+protected:
+    bool search(const MazeGrid& grid, int start, int goal, SolverWorkspace& workspace,
+                vector<Cell>& path, SolveStats& stats) override;
+    
+public:
+    const char* getName() const override { return "Dijkstra"; }
+};
+
+#endif // DIJKSTRASOLVER_HPP
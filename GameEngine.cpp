@@ -4,18 +4,39 @@
 
 #include "GameEngine.hpp"
 #include "Common.hpp"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 using namespace std;
 using namespace sf;
 
-GameEngine::GameEngine(RenderWindow* win)
+namespace {
+    const float ZOOM_IN_STEP = 0.8f;   // View scale per zoom key press or wheel notch
+    const int PENDING_POLL_MS = 50;    // How often a pending level's build is checked
+}
+
+GameEngine::GameEngine(RenderWindow* win, int levelRows, int levelCols)
     : window(win),
       currentState(GameState::NAME_INPUT),
+      finalElapsedTime(0.f),
+      redrawNeeded(true),
+      pendingLevel(0),
       nameScreen(win, &font, playerName),
       levelScreen(win, &font, playerName),
       gameScreen(win, &font, maze, playerName) {
     
+    // Size Level 3 before the pool starts building it
+    if (levelRows > 0 && levelCols > 0) {
+        GeneratorConfig config = maze.getGeneratorConfig();
+        config.rows = levelRows;
+        config.cols = levelCols;
+        maze.setGeneratorConfig(config);
+    }
+    
+    // Start building Level 3 now so selecting it doesn't stall a frame
+    maze.setPregenPool(&mazePool);
+    
     // Load font
     if (!font.openFromFile("C:/Windows/Fonts/arial.ttf")) {
         if (!font.openFromFile("arial.ttf")) {
@@ -35,12 +56,28 @@ void GameEngine::handleStateTransition(optional<GameState> newState) {
         // Handle level selection transition
         if (currentState == GameState::LEVEL_SELECT && nextState == GameState::GAMEPLAY) {
             int selectedLevel = levelScreen.getSelectedLevel();
-            if (selectedLevel >= 1 && selectedLevel <= 3) {
+            if (selectedLevel >= 1 && selectedLevel <= ENDLESS_LEVEL) {
+                // Searching for a level here would freeze the window, so
+                // stay on the level screen until the pool has one
+                if (maze.isLevelFailed(selectedLevel)) {
+                    levelScreen.setBuildFailed();
+                    redrawNeeded = true;
+                    return;
+                }
+                if (!maze.isLevelReady(selectedLevel)) {
+                    pendingLevel = selectedLevel;
+                    levelScreen.setGenerating(true);
+                    redrawNeeded = true;
+                    return;
+                }
                 maze.loadLevel(selectedLevel);
             }
         }
         
+        pendingLevel = 0;
+        levelScreen.setGenerating(false);
         currentState = nextState;
+        redrawNeeded = true;
     }
 }
 
@@ -48,72 +85,144 @@ void GameEngine::handleGameplayInput(const Event& event) {
     if (event.is<Event::KeyPressed>()) {
         const auto* keyEvent = event.getIf<Event::KeyPressed>();
         if (keyEvent) {
+            int direction = -1;
+            
             // Arrow keys
             if (keyEvent->code == Keyboard::Key::Up) {
-                maze.movePlayer(0);
+                direction = 0;
             } else if (keyEvent->code == Keyboard::Key::Down) {
-                maze.movePlayer(1);
+                direction = 1;
             } else if (keyEvent->code == Keyboard::Key::Left) {
-                maze.movePlayer(2);
+                direction = 2;
             } else if (keyEvent->code == Keyboard::Key::Right) {
-                maze.movePlayer(3);
+                direction = 3;
             }
             
             // WASD keys
             if (keyEvent->code == Keyboard::Key::W) {
-                maze.movePlayer(0);
+                direction = 0;
             } else if (keyEvent->code == Keyboard::Key::S) {
-                maze.movePlayer(1);
+                direction = 1;
             } else if (keyEvent->code == Keyboard::Key::A) {
-                maze.movePlayer(2);
+                direction = 2;
             } else if (keyEvent->code == Keyboard::Key::D) {
-                maze.movePlayer(3);
+                direction = 3;
+            }
+            
+            // A key held against a wall changes nothing on screen
+            if (direction >= 0 && maze.movePlayer(direction)) {
+                redrawNeeded = true;
+            }
+            
+            // Zoom keys, on the main row and the keypad
+            if (keyEvent->code == Keyboard::Key::Equal || keyEvent->code == Keyboard::Key::Add) {
+                gameScreen.zoomCamera(ZOOM_IN_STEP);
+                redrawNeeded = true;
+            } else if (keyEvent->code == Keyboard::Key::Hyphen || keyEvent->code == Keyboard::Key::Subtract) {
+                gameScreen.zoomCamera(1.f / ZOOM_IN_STEP);
+                redrawNeeded = true;
             }
             
             // Check for win condition
             if (maze.isGameWon()) {
+                finalElapsedTime = maze.getElapsedTime();
                 currentState = GameState::GAME_WON;
+                redrawNeeded = true;
             }
         }
+    } else if (event.is<Event::MouseWheelScrolled>()) {
+        // Wheel up zooms in, one step per notch
+        const auto* wheelEvent = event.getIf<Event::MouseWheelScrolled>();
+        if (wheelEvent && wheelEvent->delta != 0.f) {
+            gameScreen.zoomCamera(pow(ZOOM_IN_STEP, wheelEvent->delta));
+            redrawNeeded = true;
+        }
     }
 }
 
-void GameEngine::handleInput() {
-    optional<Event> eventOpt;
-    while ((eventOpt = window->pollEvent())) {
-        Event event = eventOpt.value();
-        
-        if (event.is<Event::Closed>()) {
-            window->close();
-            return;
-        }
-        
-        // ESC key handling
-        if (event.is<Event::KeyPressed>()) {
-            const auto* keyEvent = event.getIf<Event::KeyPressed>();
-            if (keyEvent && keyEvent->code == Keyboard::Key::Escape) {
-                if (currentState == GameState::GAMEPLAY) {
-                    window->close();
-                    return;
-                }
+void GameEngine::processEvent(const Event& event) {
+    if (event.is<Event::Closed>()) {
+        window->close();
+        return;
+    }
+    
+    // The window contents may have been lost or stretched; screens lay
+    // themselves out in window pixels, so the default view follows the size
+    if (const auto* resized = event.getIf<Event::Resized>()) {
+        window->setView(View(FloatRect(Vector2f(0.f, 0.f),
+                                       Vector2f(static_cast<float>(resized->size.x), static_cast<float>(resized->size.y)))));
+        redrawNeeded = true;
+    } else if (event.is<Event::FocusGained>()) {
+        redrawNeeded = true;
+    }
+    
+    // ESC key handling
+    if (event.is<Event::KeyPressed>()) {
+        const auto* keyEvent = event.getIf<Event::KeyPressed>();
+        if (keyEvent && keyEvent->code == Keyboard::Key::Escape) {
+            if (currentState == GameState::GAMEPLAY || currentState == GameState::GAME_WON) {
+                window->close();
+                return;
             }
         }
+    }
+    
+    // Delegate input to current screen
+    optional<GameState> newState = nullopt;
+    
+    if (currentState == GameState::NAME_INPUT) {
+        newState = nameScreen.handleInput(event);
         
-        // Delegate input to current screen
-        optional<GameState> newState = nullopt;
-        
-        if (currentState == GameState::NAME_INPUT) {
-            newState = nameScreen.handleInput(event);
-        } else if (currentState == GameState::LEVEL_SELECT) {
-            newState = levelScreen.handleInput(event);
-        } else if (currentState == GameState::GAMEPLAY) {
-            handleGameplayInput(event);
+        // Typing edits the name on screen
+        if (event.is<Event::TextEntered>()) {
+            redrawNeeded = true;
         }
-        // GAME_WON state handles its own input in drawWinMessage
-        
-        // Handle state transitions
-        handleStateTransition(newState);
+    } else if (currentState == GameState::LEVEL_SELECT) {
+        newState = levelScreen.handleInput(event);
+    } else if (currentState == GameState::GAMEPLAY) {
+        handleGameplayInput(event);
     }
+    
+    // Handle state transitions
+    handleStateTransition(newState);
+}
+
+void GameEngine::handleInput() {
+    optional<Event> eventOpt;
+    while (window->isOpen() && (eventOpt = window->pollEvent())) {
+        processEvent(eventOpt.value());
+    }
+}
+
+void GameEngine::loadPendingLevel() {
+    if (pendingLevel == 0) {
+        return;
+    }
+    if (maze.isLevelFailed(pendingLevel)) {
+        pendingLevel = 0;
+        levelScreen.setBuildFailed();
+        redrawNeeded = true;
+        return;
+    }
+    if (!maze.isLevelReady(pendingLevel)) {
+        return;
+    }
+    maze.loadLevel(pendingLevel);
+    pendingLevel = 0;
+    levelScreen.setGenerating(false);
+    currentState = GameState::GAMEPLAY;
+    redrawNeeded = true;
+}
+
+int GameEngine::getRedrawDelayMs() const {
+    if (currentState == GameState::NAME_INPUT) {
+        return nameScreen.getRedrawDelayMs();
+    } else if (currentState == GameState::GAMEPLAY) {
+        return gameScreen.getRedrawDelayMs();
+    } else if (pendingLevel != 0) {
+        return PENDING_POLL_MS;
+    }
+    return -1;
 }
 
 void GameEngine::render() {
@@ -126,24 +235,29 @@ void GameEngine::render() {
     } else if (currentState == GameState::GAMEPLAY) {
         gameScreen.draw();
     } else if (currentState == GameState::GAME_WON) {
-        float finalElapsedTime = maze.getElapsedTime();
         gameScreen.drawWinMessage(finalElapsedTime);
-        return;  // drawWinMessage handles its own loop
     }
     
     window->display();
+    redrawNeeded = false;
 }
 
 void GameEngine::run() {
-    while (window->isOpen() && currentState != GameState::GAME_WON) {
-        handleInput();
-        render();
-    }
-    
-    // Handle GAME_WON state (drawWinMessage has its own loop)
-    if (currentState == GameState::GAME_WON) {
-        float finalElapsedTime = maze.getElapsedTime();
-        gameScreen.drawWinMessage(finalElapsedTime);
+    while (window->isOpen()) {
+        loadPendingLevel();
+        if (redrawNeeded) {
+            render();
+        }
+        
+        // Sleep until input arrives or the screen's next timed change (a
+        // cursor blink, the clock's next second); an idle window draws nothing
+        int delay = getRedrawDelayMs();
+        optional<Event> eventOpt = window->waitEvent(delay < 0 ? Time::Zero : milliseconds(max(delay, 1)));
+        if (eventOpt) {
+            processEvent(eventOpt.value());
+            handleInput();
+        } else if (delay >= 0 && pendingLevel == 0) {
+            redrawNeeded = true;
+        }
     }
 }
-
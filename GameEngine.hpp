@@ -21,11 +21,20 @@ private:
     Font font;
     GameState currentState;
     
-    // Game model
+    // Game model; the pool builds generated levels ahead of time and
+    // outlives the maze that draws from it
+    MazePool mazePool;
     Maze maze;
     
     // Game data
     string playerName;
+    float finalElapsedTime;            // Time on the clock when the goal was reached
+    
+    // Frames are only drawn when something on screen changed
+    bool redrawNeeded;
+    
+    // Level selected while its background build was still running (0 = none)
+    int pendingLevel;
     
     // Screen instances
     NameScreen nameScreen;
@@ -35,9 +44,13 @@ private:
     // Helper methods
     void handleStateTransition(optional<GameState> newState);
     void handleGameplayInput(const Event& event);
+    void processEvent(const Event& event);
+    void loadPendingLevel();
+    int getRedrawDelayMs() const;
     
 public:
-    GameEngine(RenderWindow* win);
+    // levelRows x levelCols sizes Level 3 (0 keeps the default 15x21)
+    GameEngine(RenderWindow* win, int levelRows = 0, int levelCols = 0);
     ~GameEngine() = default;
     
     void run();
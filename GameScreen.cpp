@@ -5,170 +5,331 @@
 #include "GameScreen.hpp"
 #include "Common.hpp"
 #include <algorithm>
+#include <cmath>
 
 using namespace std;
 using namespace sf;
 
+namespace {
+    const float OVERVIEW_ZOOM = 4.f;     // From here on cells are 10 pixels or less: draw the overview
+    const float PLAYER_MIN_RADIUS = 4.f; // Screen pixels, so the player stays visible zoomed out
+    const float MINIMAP_SIZE = 160.f;    // Longest side of the minimap
+    const float MINIMAP_MAX_CELL = 8.f;  // Largest minimap cell, for small mazes
+    const float MINIMAP_MARGIN = 10.f;
+    const int CHUNK_POLL_MS = 100;       // Redraw interval while endless chunks build in the background
+    
+    // Legend captions and their offsets from the legend's top-left corner
+    struct LegendEntry {
+        const char* text;
+        unsigned size;
+        float x, y;
+    };
+    
+    const LegendEntry LEGEND_ENTRIES[] = {
+        {"Legend:", 16, 0, 0},
+        {" = Player", 14, 20, 20},
+        {" = Goal", 14, 20, 47},
+        {" = Wall", 14, 20, 72},
+        {" = Path", 14, 20, 97},
+        {" = Mud (slow)", 14, 20, 122},
+        {" = Key / Door", 14, 40, 147},
+        {" = Checkpoint", 14, 20, 172}
+    };
+}
+
 GameScreen::GameScreen(RenderWindow* win, Font* f, Maze& m, const string& name)
-    : ScreenBase(win, f), maze(m), playerName(name), 
-      lastPlayerRow(-1), lastPlayerCol(-1), cachedPath(nullopt) {
+    : ScreenBase(win, f),
+      maze(m),
+      playerName(name),
+      titleText(*f, "=== ALGOMAZE - Navigate to the Goal! ===", 20, Color::White),
+      playerNameText(*f, "", 16, Color(200, 255, 200)),
+      controlsText(*f, "Controls: Arrow Keys or WASD to move | +/- or wheel to zoom | ESC to quit", 16,
+                   Color(200, 200, 200)),
+      levelText(*f, "", 16, Color(180, 200, 255)),
+      statusText(*f, "", 16, Color(150, 255, 150)),
+      timeText(*f, "", 16, Color(255, 200, 100)),
+      stepsText(*f, "", 16, Color(200, 200, 255)),
+      keysText(*f, "", 16, GameColors::KeyColor),
+      routeText(*f, "", 16, GameColors::CheckpointColor),
+      hudValid(false),
+      winTitle(*f, "CONGRATULATIONS!", 48, Color(50, 200, 50), Text::Style::Bold),
+      winSubtitle(*f, "You successfully reached the goal!", 24, Color::White),
+      winTimeText(*f, "", 20, Color(255, 200, 100)),
+      winStepsText(*f, "", 20, Color(200, 200, 255)),
+      winPathText(*f, "", 20, Color(200, 200, 200)),
+      winExitText(*f, "Press ESC to exit", 18, Color(150, 150, 150)) {
+    for (const LegendEntry& entry : LEGEND_ENTRIES) {
+        legendLabels.emplace_back(*f, entry.text, entry.size, Color::White);
+    }
+    for (Label* label : {&winTitle, &winSubtitle, &winTimeText, &winStepsText, &winPathText, &winExitText}) {
+        label->setAnchor(Vector2f(0.5f, 0.5f));
+    }
 }
 
 void GameScreen::draw() {
-    const auto& mazeData = maze.getMazeData();
     int rows = maze.getRows();
     int cols = maze.getCols();
     
-    // Draw background
-    RectangleShape background(Vector2f(
-        cols * CELL_SIZE + WINDOW_PADDING * 2,
-        rows * CELL_SIZE + WINDOW_PADDING * 2 + 100
+    // The map is drawn through the camera, in the window above the HUD
+    Vector2u windowSize = window->getSize();
+    View screenView = window->getView();
+    camera.setArea(windowSize, Vector2f(static_cast<float>(windowSize.x),
+                                        static_cast<float>(max(static_cast<int>(windowSize.y) - HUD_HEIGHT, 1))));
+    camera.follow(Vector2f(WINDOW_PADDING + (maze.getPlayerCol() + 0.5f) * CELL_SIZE,
+                           WINDOW_PADDING + (maze.getPlayerRow() + 0.5f) * CELL_SIZE),
+                  Vector2f(static_cast<float>(cols * CELL_SIZE + WINDOW_PADDING * 2),
+                           static_cast<float>(rows * CELL_SIZE + WINDOW_PADDING * 2)));
+    window->setView(camera.getView());
+    
+    // Cells touching the visible rectangle; only those are built and drawn
+    FloatRect visibleArea = camera.getVisibleArea();
+    int firstCol = static_cast<int>(floor((visibleArea.position.x - WINDOW_PADDING) / CELL_SIZE));
+    int firstRow = static_cast<int>(floor((visibleArea.position.y - WINDOW_PADDING) / CELL_SIZE));
+    int endCol = static_cast<int>(ceil((visibleArea.position.x + visibleArea.size.x - WINDOW_PADDING) / CELL_SIZE));
+    int endRow = static_cast<int>(ceil((visibleArea.position.y + visibleArea.size.y - WINDOW_PADDING) / CELL_SIZE));
+    IntRect visibleCells(Vector2i(firstCol, firstRow), Vector2i(endCol - firstCol, endRow - firstRow));
+    bool wholeMazeVisible = firstCol <= 0 && firstRow <= 0 && endCol >= cols && endRow >= rows;
+    
+    // Far out, the overview texture stands in for the cell geometry; both
+    // follow the maze's change log, so only what changed is redrawn
+    bool farZoom = camera.getZoom() >= OVERVIEW_ZOOM;
+    if (farZoom || !wholeMazeVisible) {
+        overview.update(maze);
+    }
+    if (farZoom && overview.isReady()) {
+        overview.draw(*window, Vector2f(WINDOW_PADDING, WINDOW_PADDING), static_cast<float>(CELL_SIZE));
+    } else {
+        // The grid and its decorations come from the renderer's cached layer
+        renderer.update(maze, visibleCells);
+        renderer.draw(*window);
+    }
+    
+    // Goal glow over the layer
+    int goalRow = maze.getGoalRow();
+    int goalCol = maze.getGoalCol();
+    if (goalRow >= 0 && goalRow < rows && goalCol >= 0 && goalCol < cols) {
+        CircleShape glow(CELL_SIZE / 1.5f);
+        glow.setFillColor(Color(GameColors::GoalColor.r, GameColors::GoalColor.g, GameColors::GoalColor.b, 100));
+        glow.setPosition(Vector2f(
+            WINDOW_PADDING + goalCol * CELL_SIZE + CELL_SIZE / 6,
+            WINDOW_PADDING + goalRow * CELL_SIZE + CELL_SIZE / 6
+        ));
+        window->draw(glow);
+    }
+    
+    // Player - draw as circle on top of whatever terrain it stands on,
+    // growing past its cell when zoomed out far enough to lose it
+    float playerRadius = max(CELL_SIZE / 2.f - 2, PLAYER_MIN_RADIUS * camera.getZoom());
+    CircleShape playerCircle(playerRadius);
+    playerCircle.setFillColor(GameColors::PlayerColor);
+    playerCircle.setOrigin(Vector2f(playerRadius, playerRadius));
+    playerCircle.setPosition(Vector2f(
+        WINDOW_PADDING + maze.getPlayerCol() * CELL_SIZE + CELL_SIZE / 2.f - 1,
+        WINDOW_PADDING + maze.getPlayerRow() * CELL_SIZE + CELL_SIZE / 2.f - 1
     ));
-    background.setFillColor(GameColors::BackgroundColor);
-    background.setPosition(Vector2f(0, 0));
-    window->draw(background);
-    
-    // Draw each cell
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
-            RectangleShape cell(Vector2f(CELL_SIZE - 2, CELL_SIZE - 2));
-            cell.setPosition(Vector2f(
-                WINDOW_PADDING + j * CELL_SIZE + 1,
-                WINDOW_PADDING + i * CELL_SIZE + 1
-            ));
-            
-            if (mazeData[i][j] == '#') {
-                // Wall
-                cell.setFillColor(GameColors::WallColor);
-            } else if (mazeData[i][j] == 'P') {
-                // Player - draw as circle
-                CircleShape playerCircle(CELL_SIZE / 2 - 2);
-                playerCircle.setFillColor(GameColors::PlayerColor);
-                playerCircle.setPosition(Vector2f(
-                    WINDOW_PADDING + j * CELL_SIZE + 1,
-                    WINDOW_PADDING + i * CELL_SIZE + 1
-                ));
-                window->draw(cell);
-                window->draw(playerCircle);
-                continue;
-            } else if (mazeData[i][j] == 'G') {
-                // Goal - draw with glow effect
-                cell.setFillColor(GameColors::GoalColor);
-                CircleShape glow(CELL_SIZE / 1.5f);
-                glow.setFillColor(Color(GameColors::GoalColor.r, GameColors::GoalColor.g, GameColors::GoalColor.b, 100));
-                glow.setPosition(Vector2f(
-                    WINDOW_PADDING + j * CELL_SIZE + CELL_SIZE / 6,
-                    WINDOW_PADDING + i * CELL_SIZE + CELL_SIZE / 6
-                ));
-                window->draw(cell);
-                window->draw(glow);
-            } else {
-                // Path
-                cell.setFillColor(GameColors::PathColor);
-            }
-            
-            window->draw(cell);
-        }
+    window->draw(playerCircle);
+    
+    // Draw UI text in screen coordinates; labels are only re-formatted when
+    // the values behind them change
+    window->setView(screenView);
+    
+    // Minimap, only while part of the maze is off screen
+    if (!wholeMazeVisible) {
+        drawMinimap(visibleArea);
     }
     
-    // Draw UI text
-    int windowWidth = cols * CELL_SIZE + WINDOW_PADDING * 2;
-    int textY = rows * CELL_SIZE + WINDOW_PADDING + 20;
+    int textY = static_cast<int>(windowSize.y) - HUD_HEIGHT;
+    if (maze.isEndless()) {
+        maze.collectBuiltChunks();
+    }
+    updateHud();
     
-    Text titleText(*font, "=== ALGOMAZE - Navigate to the Goal! ===", 20);
-    titleText.setFillColor(Color::White);
     titleText.setPosition(Vector2f(20, textY));
-    window->draw(titleText);
-    
-    // Display player name
-    Text playerNameText(*font, "Player: " + playerName, 16);
-    playerNameText.setFillColor(Color(200, 255, 200));
+    titleText.draw(*window);
     playerNameText.setPosition(Vector2f(20, textY + 20));
-    window->draw(playerNameText);
-    
-    Text controlsText(*font, "Controls: Arrow Keys or WASD to move | ESC to quit", 16);
-    controlsText.setFillColor(Color(200, 200, 200));
+    playerNameText.draw(*window);
     controlsText.setPosition(Vector2f(20, textY + 40));
-    window->draw(controlsText);
+    controlsText.draw(*window);
+    levelText.setPosition(Vector2f(20, textY + 60));
+    levelText.draw(*window);
+    statusText.setPosition(Vector2f(20, textY + 80));
+    statusText.draw(*window);
+    timeText.setPosition(Vector2f(20, textY + 100));
+    timeText.draw(*window);
+    stepsText.setPosition(Vector2f(20, textY + 120));
+    stepsText.draw(*window);
+    
+    // Keys collected, only on levels that have keys or doors
+    if (maze.isKeyGated()) {
+        keysText.setPosition(Vector2f(20, textY + 140));
+        keysText.draw(*window);
+    }
     
-    // Get shortest path (cache if needed)
-    int currentPlayerRow = maze.getPlayerRow();
-    int currentPlayerCol = maze.getPlayerCol();
+    // Best order through the remaining checkpoints and keys
+    if (maze.hasWaypoints() && maze.tracksRoute()) {
+        routeText.setPosition(Vector2f(160, textY + 140));
+        routeText.draw(*window);
+    }
     
-    if (!cachedPath.has_value() || lastPlayerRow != currentPlayerRow || lastPlayerCol != currentPlayerCol) {
-        cachedPath = maze.findShortestPath();
-        lastPlayerRow = currentPlayerRow;
-        lastPlayerCol = currentPlayerCol;
+    // Legend - positioned at bottom-right corner
+    int legendX = static_cast<int>(windowSize.x) - 220;
+    int legendY = static_cast<int>(windowSize.y) - 196;
+    drawLegend(legendX, legendY);
+}
+
+void GameScreen::drawMinimap(const FloatRect& visibleArea) {
+    if (!overview.isReady()) {
+        return;
     }
-    optional<vector<Cell>> pathOpt = cachedPath;
+    int rows = maze.getRows();
+    int cols = maze.getCols();
     
-    // UI elements below maze
-    Text levelText(*font, "Level " + to_string(maze.getCurrentLevel()) + " of 3", 16);
-    levelText.setFillColor(Color(180, 200, 255));
-    levelText.setPosition(Vector2f(20, textY + 60));
-    window->draw(levelText);
-    
-    // Shortest Path
-    if (pathOpt.has_value()) {
-        int pathSteps = static_cast<int>(pathOpt.value().size()) - 1;
-        Text pathText(*font, "Shortest Path: " + to_string(pathSteps) + " steps", 16);
-        pathText.setFillColor(Color(150, 255, 150));
-        pathText.setPosition(Vector2f(20, textY + 80));
-        window->draw(pathText);
-    } else {
-        Text pathText(*font, "Goal is unreachable!", 16);
-        pathText.setFillColor(Color(255, 150, 150));
-        pathText.setPosition(Vector2f(20, textY + 80));
-        window->draw(pathText);
+    // Whole maze in the top-right corner of the map area
+    float cellSize = min(MINIMAP_MAX_CELL, MINIMAP_SIZE / max(rows, cols));
+    Vector2f mapSize(cols * cellSize, rows * cellSize);
+    Vector2f mapPosition(window->getSize().x - MINIMAP_MARGIN - mapSize.x, MINIMAP_MARGIN);
+    
+    RectangleShape frame(mapSize);
+    frame.setPosition(mapPosition);
+    frame.setFillColor(GameColors::BackgroundColor);
+    frame.setOutlineColor(Color(200, 200, 200));
+    frame.setOutlineThickness(2);
+    window->draw(frame);
+    overview.draw(*window, mapPosition, cellSize);
+    
+    // Outline of the part of the maze on screen, clipped to the minimap
+    float scale = cellSize / CELL_SIZE;
+    float left = max(0.f, (visibleArea.position.x - WINDOW_PADDING) * scale);
+    float top = max(0.f, (visibleArea.position.y - WINDOW_PADDING) * scale);
+    float right = min(mapSize.x, (visibleArea.position.x + visibleArea.size.x - WINDOW_PADDING) * scale);
+    float bottom = min(mapSize.y, (visibleArea.position.y + visibleArea.size.y - WINDOW_PADDING) * scale);
+    if (right > left && bottom > top) {
+        RectangleShape viewFrame(Vector2f(right - left, bottom - top));
+        viewFrame.setPosition(mapPosition + Vector2f(left, top));
+        viewFrame.setFillColor(Color::Transparent);
+        viewFrame.setOutlineColor(Color::White);
+        viewFrame.setOutlineThickness(1);
+        window->draw(viewFrame);
     }
     
-    // Display elapsed time
-    float elapsed = maze.getElapsedTime();
-    int seconds = static_cast<int>(elapsed);
-    int minutes = seconds / 60;
-    seconds = seconds % 60;
-    
-    string elapsedTimeStr = "Elapsed: ";
-    if (minutes > 0) {
-        elapsedTimeStr += to_string(minutes) + "m ";
+    // Player
+    CircleShape playerDot(3);
+    playerDot.setFillColor(GameColors::PlayerColor);
+    playerDot.setOrigin(Vector2f(3, 3));
+    playerDot.setPosition(mapPosition + Vector2f((maze.getPlayerCol() + 0.5f) * cellSize,
+                                                 (maze.getPlayerRow() + 0.5f) * cellSize));
+    window->draw(playerDot);
+}
+
+void GameScreen::zoomCamera(float factor) {
+    camera.zoomBy(factor);
+}
+
+void GameScreen::updateHud() {
+    if (!hudValid || shownName != playerName) {
+        shownName = playerName;
+        playerNameText.setString("Player: " + playerName);
     }
-    elapsedTimeStr += to_string(seconds) + "s";
     
-    Text timeText(*font, elapsedTimeStr, 16);
-    timeText.setFillColor(Color(255, 200, 100));
-    timeText.setPosition(Vector2f(20, textY + 100));
-    window->draw(timeText);
+    // Level, or the player's world position in endless mode
+    HudValues now;
+    now.level = maze.getCurrentLevel();
+    now.worldRow = maze.isEndless() ? maze.getWorldRow() : 0;
+    now.worldCol = maze.isEndless() ? maze.getWorldCol() : 0;
+    if (!hudValid || now.level != shown.level || now.worldRow != shown.worldRow || now.worldCol != shown.worldCol) {
+        levelText.setString(maze.isEndless()
+            ? "Endless World at (" + to_string(now.worldRow) + ", " + to_string(now.worldCol) + ")"
+            : "Level " + to_string(now.level) + " of 3");
+    }
+    
+    // Shortest path length and cost are lookups in the maze's goal distance
+    // field; endless mode shows the chunk cache instead
+    optional<int> pathLength = maze.getShortestPathLength();
+    optional<int> pathCost = maze.getShortestPathCost();
+    const ChunkWorld& world = maze.getWorld();
+    now.endless = maze.isEndless();
+    now.pathLength = pathLength.value_or(-1);
+    now.pathCost = pathCost.value_or(-1);
+    now.loadedChunks = now.endless ? static_cast<long long>(world.getLoadedChunks()) : 0;
+    now.builtChunks = now.endless ? world.getBuiltChunks() : 0;
+    if (!hudValid || now.endless != shown.endless || now.pathLength != shown.pathLength ||
+        now.pathCost != shown.pathCost || now.loadedChunks != shown.loadedChunks ||
+        now.builtChunks != shown.builtChunks) {
+        if (now.endless) {
+            statusText.setString("No goal - explore! Chunks cached: " + to_string(now.loadedChunks) +
+                                 " / " + to_string(world.getCapacity()) + ", built: " + to_string(now.builtChunks));
+            statusText.setColor(Color(150, 255, 150));
+        } else if (pathLength.has_value()) {
+            string pathStr = "Shortest Path: " + to_string(now.pathLength) + " steps";
+            if (now.pathCost != now.pathLength) {
+                pathStr += " (cost " + to_string(now.pathCost) + ")";
+            }
+            statusText.setString(pathStr);
+            statusText.setColor(Color(150, 255, 150));
+        } else {
+            statusText.setString("Goal is unreachable!");
+            statusText.setColor(Color(255, 150, 150));
+        }
+    }
+    
+    // Display elapsed time
+    now.seconds = static_cast<int>(maze.getElapsedTime());
+    if (!hudValid || now.seconds != shown.seconds) {
+        int minutes = now.seconds / 60;
+        string elapsedTimeStr = "Elapsed: ";
+        if (minutes > 0) {
+            elapsedTimeStr += to_string(minutes) + "m ";
+        }
+        elapsedTimeStr += to_string(now.seconds % 60) + "s";
+        timeText.setString(elapsedTimeStr);
+    }
     
     // Steps Taken
-    Text stepsText(*font, "Steps Taken: " + to_string(maze.getStepsTaken()), 16);
-    stepsText.setFillColor(Color(200, 200, 255));
-    stepsText.setPosition(Vector2f(20, textY + 120));
-    window->draw(stepsText);
+    now.steps = maze.getStepsTaken();
+    if (!hudValid || now.steps != shown.steps) {
+        stepsText.setString("Steps Taken: " + to_string(now.steps));
+    }
     
-    // Legend - positioned at bottom-right corner
-    Vector2u windowSize = window->getSize();
-    int legendX = static_cast<int>(windowSize.x) - 220;
-    int legendY = static_cast<int>(windowSize.y) - 121;
-    drawLegend(legendX, legendY);
+    // Keys collected
+    now.heldKeys = maze.getHeldKeys();
+    now.requiredKeys = maze.getRequiredKeys();
+    if (!hudValid || now.heldKeys != shown.heldKeys || now.requiredKeys != shown.requiredKeys) {
+        int held = 0;
+        int total = 0;
+        for (int type = 0; type < MAX_KEY_TYPES; type++) {
+            held += (now.heldKeys >> type) & 1;
+            total += ((now.heldKeys | now.requiredKeys) >> type) & 1;
+        }
+        keysText.setString("Keys: " + to_string(held) + " / " + to_string(total));
+    }
+    
+    // Optimal route, re-solved by the maze only when the player's state changes
+    now.routeCost = -1;
+    now.routeStops = 0;
+    if (maze.hasWaypoints() && maze.tracksRoute()) {
+        optional<RoutePlan> route = maze.findOptimalRoute();
+        if (route.has_value()) {
+            now.routeCost = route->cost;
+            now.routeStops = static_cast<int>(route->stops.size()) - 1;
+        }
+    }
+    if (!hudValid || now.routeCost != shown.routeCost || now.routeStops != shown.routeStops) {
+        routeText.setString(now.routeCost >= 0
+            ? "Checkpoint Tour: " + to_string(now.routeCost) + " via " + to_string(now.routeStops) + " stops"
+            : "Checkpoint Tour: none");
+    }
+    
+    shown = now;
+    hudValid = true;
 }
 
 void GameScreen::drawLegend(int x, int y) {
-    Text legendTitle(*font, "Legend:", 16);
-    legendTitle.setFillColor(Color::White);
-    legendTitle.setPosition(Vector2f(x, y));
-    window->draw(legendTitle);
-    
     // Player
     CircleShape playerIcon(8);
     playerIcon.setFillColor(GameColors::PlayerColor);
     playerIcon.setPosition(Vector2f(x, y + 25));
     window->draw(playerIcon);
     
-    Text playerText(*font, " = Player", 14);
-    playerText.setFillColor(Color::White);
-    playerText.setPosition(Vector2f(x + 20, y + 20));
-    window->draw(playerText);
-    
     // Goal - draw with glow effect
     RectangleShape goalIcon(Vector2f(16, 16));
     goalIcon.setFillColor(GameColors::GoalColor);
@@ -180,37 +341,49 @@ void GameScreen::drawLegend(int x, int y) {
     goalGlow.setPosition(Vector2f(x + 3.0f, y + 53.0f));
     window->draw(goalGlow);
     
-    Text goalText(*font, " = Goal", 14);
-    goalText.setFillColor(Color::White);
-    goalText.setPosition(Vector2f(x + 20, y + 47));
-    window->draw(goalText);
-    
     // Wall
     RectangleShape wallIcon(Vector2f(16, 16));
     wallIcon.setFillColor(GameColors::WallColor);
     wallIcon.setPosition(Vector2f(x, y + 75));
     window->draw(wallIcon);
     
-    Text wallText(*font, " = Wall", 14);
-    wallText.setFillColor(Color::White);
-    wallText.setPosition(Vector2f(x + 20, y + 72));
-    window->draw(wallText);
-    
     // Path
     RectangleShape pathIcon(Vector2f(16, 16));
     pathIcon.setFillColor(GameColors::PathColor);
     pathIcon.setPosition(Vector2f(x, y + 100));
     window->draw(pathIcon);
     
-    Text pathText(*font, " = Path", 14);
-    pathText.setFillColor(Color::White);
-    pathText.setPosition(Vector2f(x + 20, y + 97));
-    window->draw(pathText);
+    // Mud
+    RectangleShape mudIcon(Vector2f(16, 16));
+    mudIcon.setFillColor(GameColors::MudColor);
+    mudIcon.setPosition(Vector2f(x, y + 125));
+    window->draw(mudIcon);
+    
+    // Key and door
+    CircleShape keyIcon(6);
+    keyIcon.setFillColor(GameColors::KeyColor);
+    keyIcon.setPosition(Vector2f(x + 2, y + 152));
+    window->draw(keyIcon);
+    
+    RectangleShape doorIcon(Vector2f(16, 16));
+    doorIcon.setFillColor(GameColors::ObstacleColor);
+    doorIcon.setPosition(Vector2f(x + 20, y + 150));
+    window->draw(doorIcon);
+    
+    // Checkpoint
+    CircleShape checkpointIcon(8, 4);
+    checkpointIcon.setFillColor(GameColors::CheckpointColor);
+    checkpointIcon.setPosition(Vector2f(x, y + 175));
+    window->draw(checkpointIcon);
+    
+    // Captions
+    for (size_t i = 0; i < legendLabels.size(); i++) {
+        legendLabels[i].setPosition(Vector2f(x + LEGEND_ENTRIES[i].x, y + LEGEND_ENTRIES[i].y));
+        legendLabels[i].draw(*window);
+    }
 }
 
 void GameScreen::drawWinMessage(float finalElapsedTime) {
-    window->clear(GameColors::BackgroundColor);
-    
     int finalSeconds = static_cast<int>(finalElapsedTime);
     int finalMinutes = finalSeconds / 60;
     finalSeconds = finalSeconds % 60;
@@ -221,143 +394,44 @@ void GameScreen::drawWinMessage(float finalElapsedTime) {
     }
     finalTimeStr += to_string(finalSeconds) + "s";
     
-    // Draw win message
-    Text winTitle(*font, "CONGRATULATIONS!", 48);
-    winTitle.setFillColor(Color(50, 200, 50));
-    winTitle.setStyle(Text::Style::Bold);
+    // Centred on the window; the title, subtitle and exit hint never change
+    float centerX = window->getSize().x / 2.0f;
+    float centerY = window->getSize().y / 2.0f;
     
-    FloatRect textRect = winTitle.getLocalBounds();
-    winTitle.setOrigin(Vector2f(
-        textRect.position.x + textRect.size.x / 2.0f,
-        textRect.position.y + textRect.size.y / 2.0f
-    ));
-    winTitle.setPosition(Vector2f(
-        window->getSize().x / 2.0f,
-        window->getSize().y / 2.0f - 100
-    ));
-    window->draw(winTitle);
-    
-    Text winSubtitle(*font, "You successfully reached the goal!", 24);
-    winSubtitle.setFillColor(Color::White);
+    winTitle.setPosition(Vector2f(centerX, centerY - 100));
+    winTitle.draw(*window);
     
-    textRect = winSubtitle.getLocalBounds();
-    winSubtitle.setOrigin(Vector2f(
-        textRect.position.x + textRect.size.x / 2.0f,
-        textRect.position.y + textRect.size.y / 2.0f
-    ));
-    winSubtitle.setPosition(Vector2f(
-        window->getSize().x / 2.0f,
-        window->getSize().y / 2.0f - 50
-    ));
-    window->draw(winSubtitle);
+    winSubtitle.setPosition(Vector2f(centerX, centerY - 50));
+    winSubtitle.draw(*window);
     
     // Display final time
-    Text timeText(*font, "Time: " + finalTimeStr, 20);
-    timeText.setFillColor(Color(255, 200, 100));
-    
-    textRect = timeText.getLocalBounds();
-    timeText.setOrigin(Vector2f(
-        textRect.position.x + textRect.size.x / 2.0f,
-        textRect.position.y + textRect.size.y / 2.0f
-    ));
-    timeText.setPosition(Vector2f(
-        window->getSize().x / 2.0f,
-        window->getSize().y / 2.0f + 10
-    ));
-    window->draw(timeText);
+    winTimeText.setString("Time: " + finalTimeStr);
+    winTimeText.setPosition(Vector2f(centerX, centerY + 10));
+    winTimeText.draw(*window);
     
     // Display total steps taken
-    Text stepsText(*font, "Steps Taken: " + to_string(maze.getStepsTaken()), 20);
-    stepsText.setFillColor(Color(200, 200, 255));
-    
-    textRect = stepsText.getLocalBounds();
-    stepsText.setOrigin(Vector2f(
-        textRect.position.x + textRect.size.x / 2.0f,
-        textRect.position.y + textRect.size.y / 2.0f
-    ));
-    stepsText.setPosition(Vector2f(
-        window->getSize().x / 2.0f,
-        window->getSize().y / 2.0f + 40
-    ));
-    window->draw(stepsText);
-    
-    optional<vector<Cell>> pathOpt = maze.findShortestPath();
-    if (pathOpt.has_value()) {
-        int pathSteps = static_cast<int>(pathOpt.value().size()) - 1;
-        Text pathText(*font, "Shortest Path: " + to_string(pathSteps) + " steps", 20);
-        pathText.setFillColor(Color(200, 200, 200));
-        
-        textRect = pathText.getLocalBounds();
-        pathText.setOrigin(Vector2f(
-            textRect.position.x + textRect.size.x / 2.0f,
-            textRect.position.y + textRect.size.y / 2.0f
-        ));
-        pathText.setPosition(Vector2f(
-            window->getSize().x / 2.0f,
-            window->getSize().y / 2.0f + 70
-        ));
-        window->draw(pathText);
+    winStepsText.setString("Steps Taken: " + to_string(maze.getStepsTaken()));
+    winStepsText.setPosition(Vector2f(centerX, centerY + 40));
+    winStepsText.draw(*window);
+    
+    optional<int> pathLength = maze.getShortestPathLength();
+    if (pathLength.has_value()) {
+        winPathText.setString("Shortest Path: " + to_string(pathLength.value()) + " steps");
+        winPathText.setPosition(Vector2f(centerX, centerY + 70));
+        winPathText.draw(*window);
     }
     
-    Text exitText(*font, "Press ESC to exit", 18);
-    exitText.setFillColor(Color(150, 150, 150));
-    
-    textRect = exitText.getLocalBounds();
-    exitText.setOrigin(Vector2f(
-        textRect.position.x + textRect.size.x / 2.0f,
-        textRect.position.y + textRect.size.y / 2.0f
-    ));
-    exitText.setPosition(Vector2f(
-        window->getSize().x / 2.0f,
-        window->getSize().y / 2.0f + 110
-    ));
-    window->draw(exitText);
-    
-    window->display();
-    
-    // Window waiting loop - only responds to ESC key
-    while (window->isOpen()) {
-        optional<Event> eventOpt;
-        while ((eventOpt = window->pollEvent())) {
-            Event event = eventOpt.value();
-            
-            if (event.is<Event::Closed>()) {
-                window->close();
-                return;
-            }
-            
-            if (event.is<Event::KeyPressed>()) {
-                const auto* keyEvent = event.getIf<Event::KeyPressed>();
-                if (keyEvent && keyEvent->code == Keyboard::Key::Escape) {
-                    window->close();
-                    return;
-                }
-            }
-        }
-        
-        // Keep the window updated while waiting
-        window->clear(GameColors::BackgroundColor);
-        window->draw(winTitle);
-        window->draw(winSubtitle);
-        window->draw(timeText);
-        window->draw(stepsText);
-        if (pathOpt.has_value()) {
-            int pathSteps = static_cast<int>(pathOpt.value().size()) - 1;
-            Text pathText(*font, "Shortest Path: " + to_string(pathSteps) + " steps", 20);
-            pathText.setFillColor(Color(200, 200, 200));
-            textRect = pathText.getLocalBounds();
-            pathText.setOrigin(Vector2f(
-                textRect.position.x + textRect.size.x / 2.0f,
-                textRect.position.y + textRect.size.y / 2.0f
-            ));
-            pathText.setPosition(Vector2f(
-                window->getSize().x / 2.0f,
-                window->getSize().y / 2.0f + 70
-            ));
-            window->draw(pathText);
-        }
-        window->draw(exitText);
-        window->display();
-    }
+    winExitText.setPosition(Vector2f(centerX, centerY + 110));
+    winExitText.draw(*window);
 }
 
+int GameScreen::getRedrawDelayMs() const {
+    // The elapsed time readout ticks over on whole seconds, and the chunk
+    // counters whenever a background build lands
+    int elapsedMs = static_cast<int>(maze.getElapsedTime() * 1000);
+    int delay = 1000 - elapsedMs % 1000;
+    if (maze.isEndless() && maze.getWorld().isBuilding()) {
+        delay = min(delay, CHUNK_POLL_MS);
+    }
+    return delay;
+}
@@ -7,6 +7,10 @@
 
 #include "ScreenBase.hpp"
 #include "Maze.hpp"
+#include "MazeRenderer.hpp"
+#include "MazeOverview.hpp"
+#include "Camera.hpp"
+#include "Label.hpp"
 #include "Common.hpp"
 #include <SFML/Graphics.hpp>
 #include <string>
@@ -20,14 +24,54 @@ class GameScreen : public ScreenBase {
 private:
     Maze& maze;  // Reference to maze model
     const string& playerName;  // Reference to player name
-    optional<vector<Cell>> cachedPath;  // Cached shortest path
-    int lastPlayerRow, lastPlayerCol;  // Track player position for cache invalidation
+    MazeRenderer renderer;     // Batched grid geometry
+    MazeOverview overview;     // One texel per cell, for far zoom and the minimap
+    Camera camera;             // Follows the player over the map area
+    
+    // HUD labels, re-formatted only when the values in 'shown' change
+    struct HudValues {
+        int level;
+        int64_t worldRow, worldCol;
+        bool endless;
+        int pathLength, pathCost;
+        long long loadedChunks, builtChunks;
+        int seconds;
+        int steps;
+        unsigned heldKeys, requiredKeys;
+        int routeCost, routeStops;
+    };
+    Label titleText;
+    Label playerNameText;
+    Label controlsText;
+    Label levelText;
+    Label statusText;          // Shortest path, or the chunk cache in endless mode
+    Label timeText;
+    Label stepsText;
+    Label keysText;
+    Label routeText;
+    HudValues shown;
+    string shownName;
+    bool hudValid;
+    
+    vector<Label> legendLabels;
+    
+    Label winTitle;
+    Label winSubtitle;
+    Label winTimeText;
+    Label winStepsText;
+    Label winPathText;
+    Label winExitText;
+    
+    void updateHud();
+    void drawMinimap(const FloatRect& visibleArea);
     
 public:
     GameScreen(RenderWindow* win, Font* f, Maze& m, const string& name);
     void draw() override;
+    void zoomCamera(float factor);
     void drawLegend(int x, int y);
     void drawWinMessage(float finalElapsedTime);
+    int getRedrawDelayMs() const override;
 };
 
 #endif // GAMESCREEN_HPP
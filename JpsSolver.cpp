@@ -0,0 +1,133 @@
+/*
+ * JpsSolver.cpp - Jump Point Search strategy implementation
+ */
+
+#include "JpsSolver.hpp"
+#include "AStarSolver.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+int JpsSolver::jumpHorizontal(const MazeGrid& grid, int idx, int step, int goal) const {
+    int up = grid.neighborOffset(0);
+    int down = grid.neighborOffset(1);
+    
+    for (idx += step; grid.isOpen(idx); idx += step) {
+        if (idx == goal) {
+            return idx;
+        }
+        // Forced neighbour: a vertical opening the previous cell did not have
+        if ((grid.isOpen(idx + up) && !grid.isOpen(idx + up - step)) ||
+            (grid.isOpen(idx + down) && !grid.isOpen(idx + down - step))) {
+            return idx;
+        }
+    }
+    return -1;
+}
+
+int JpsSolver::jumpVertical(const MazeGrid& grid, int idx, int step, int goal) const {
+    for (idx += step; grid.isOpen(idx); idx += step) {
+        if (idx == goal) {
+            return idx;
+        }
+        if (jumpHorizontal(grid, idx, -1, goal) >= 0 || jumpHorizontal(grid, idx, 1, goal) >= 0) {
+            return idx;
+        }
+    }
+    return -1;
+}
+
+bool JpsSolver::search(const MazeGrid& grid, int start, int goal, SolverWorkspace& workspace,
+                       vector<Cell>& path, SolveStats& stats) {
+    workspace.begin(grid.getCellCount());
+    vector<OpenEntry>& open = workspace.openList();
+    
+    int stride = grid.getStride();
+    int goalRow = grid.rowOf(goal);
+    int goalCol = grid.colOf(goal);
+    auto distance = [&](int a, int b) {
+        return abs(grid.rowOf(a) - grid.rowOf(b)) + abs(grid.colOf(a) - grid.colOf(b));
+    };
+    auto heuristic = [&](int idx) {
+        return abs(grid.rowOf(idx) - goalRow) + abs(grid.colOf(idx) - goalCol);
+    };
+    
+    workspace.visit(start, -1, 0);
+    open.push_back({heuristic(start), 0, start});
+    
+    while (!open.empty()) {
+        pop_heap(open.begin(), open.end(), openEntryAfter);
+        OpenEntry current = open.back();
+        open.pop_back();
+        
+        if (current.cost != workspace.getCost(current.idx)) {
+            continue;
+        }
+        stats.nodesExpanded++;
+        
+        if (current.idx == goal) {
+            break;
+        }
+        
+        // Prune by arrival direction: keep going the same way plus both
+        // perpendicular directions; the start node scans all four
+        int steps[4];
+        int stepCount = 0;
+        int from = workspace.getParent(current.idx);
+        if (from < 0) {
+            steps[stepCount++] = -stride;
+            steps[stepCount++] = stride;
+            steps[stepCount++] = -1;
+            steps[stepCount++] = 1;
+        } else if (grid.rowOf(from) == grid.rowOf(current.idx)) {
+            steps[stepCount++] = current.idx > from ? 1 : -1;
+            steps[stepCount++] = -stride;
+            steps[stepCount++] = stride;
+        } else {
+            steps[stepCount++] = current.idx > from ? stride : -stride;
+            steps[stepCount++] = -1;
+            steps[stepCount++] = 1;
+        }
+        
+        for (int i = 0; i < stepCount; i++) {
+            int step = steps[i];
+            int jump = (step == 1 || step == -1)
+                ? jumpHorizontal(grid, current.idx, step, goal)
+                : jumpVertical(grid, current.idx, step, goal);
+            if (jump < 0) {
+                continue;
+            }
+            
+            int nextCost = current.cost + distance(current.idx, jump);
+            if (!workspace.isVisited(jump) || nextCost < workspace.getCost(jump)) {
+                workspace.visit(jump, current.idx, nextCost);
+                open.push_back({nextCost + heuristic(jump), nextCost, jump});
+                push_heap(open.begin(), open.end(), openEntryAfter);
+            }
+        }
+    }
+    
+    if (!workspace.isVisited(goal)) {
+        return false;
+    }
+    
+    // Parent links join jump points by straight segments; expand them into
+    // single cells, filling the path from the goal backwards
+    int length = workspace.getCost(goal);
+    path.resize(length + 1);
+    int step = length;
+    int idx = goal;
+    while (idx != start) {
+        int from = workspace.getParent(idx);
+        int delta = grid.rowOf(from) == grid.rowOf(idx)
+            ? (idx > from ? 1 : -1)
+            : (idx > from ? stride : -stride);
+        for (; idx != from; idx -= delta) {
+            path[step] = Cell(grid.rowOf(idx), grid.colOf(idx), step);
+            step--;
+        }
+    }
+    path[0] = Cell(grid.rowOf(start), grid.colOf(start), 0);
+    return true;
+}
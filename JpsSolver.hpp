@@ -0,0 +1,28 @@
+/*
+ * JpsSolver.hpp - Jump Point Search strategy for 4-connected grids
+ */
+
+#ifndef JPSSOLVER_HPP
+#define JPSSOLVER_HPP
+
+#include "PathSolver.hpp"
+
+// A* over jump points. Horizontal scans stop at cells with a forced vertical
+// neighbour; vertical scans stop wherever a horizontal scan from the current
+// cell would find a jump point. Straight runs of corridor or open floor are
+// crossed without pushing their cells, so in open rooms only a small fraction
+// of the cells BFS visits ever reach the open list.
+class JpsSolver : public PathSolver {
+private:
+    int jumpHorizontal(const MazeGrid& grid, int idx, int step, int goal) const;
+    int jumpVertical(const MazeGrid& grid, int idx, int step, int goal) const;
+    
+protected:
+    bool search(const MazeGrid& grid, int start, int goal, SolverWorkspace& workspace,
+                vector<Cell>& path, SolveStats& stats) override;
+    
+public:
+    const char* getName() const override { return "JPS"; }
+};
+
+#endif // JPSSOLVER_HPP
@@ -0,0 +1,333 @@
+/*
+ * KeySolver.cpp - Key-gated state-space search implementation
+ */
+
+#include "KeySolver.hpp"
+#include <algorithm>
+
+using namespace std;
+using namespace sf;
+
+namespace {
+    // Queue entry code layout: bits 1-2 = direction taken into the cell,
+    // bit 0 = a key was picked up on entering it
+    const int CODE_BITS = 3;
+    
+    inline uint8_t parentCode(int dir, bool pickup) {
+        return static_cast<uint8_t>((dir << 1) | (pickup ? 1 : 0));
+    }
+    
+    // 32 two-bit directions per word
+    inline int readDirection(const vector<uint64_t>& words, int idx) {
+        return static_cast<int>((words[idx >> 5] >> ((idx & 31) * 2)) & 3);
+    }
+    
+    inline void writeDirection(vector<uint64_t>& words, int idx, int dir) {
+        uint64_t& word = words[idx >> 5];
+        int shift = (idx & 31) * 2;
+        word = (word & ~(uint64_t(3) << shift)) | (static_cast<uint64_t>(dir) << shift);
+    }
+    
+    const int UNREACHABLE = -1;
+}
+
+KeySolver::KeySolver()
+    : settled(1u << MAX_KEY_TYPES),
+      parents(1u << MAX_KEY_TYPES),
+      pickups(1u << MAX_KEY_TYPES),
+      maskReady(1u << MAX_KEY_TYPES, false),
+      keyFields(MAX_KEY_TYPES),
+      goalIndex(-1),
+      placedKeys(0) {
+    fill(keyToGoal, keyToGoal + MAX_KEY_TYPES, UNREACHABLE);
+}
+
+// Reverse Dijkstra over door-less terrain: field[u] is the cheapest cost of
+// walking from u onto any of the 'targets'
+void KeySolver::buildField(const MazeGrid& grid, const vector<int>& targets, vector<int>& field) {
+    field.assign(grid.getCellCount(), UNREACHABLE);
+    queue.reset(MAX_CELL_COST);
+    
+    for (int idx : targets) {
+        field[idx] = 0;
+        queue.push(static_cast<uint64_t>(idx), 0);
+    }
+    
+    while (!queue.empty()) {
+        int dist;
+        int idx = static_cast<int>(queue.pop(dist));
+        if (dist != field[idx]) {
+            continue;  // Stale entry
+        }
+        
+        // Stepping from a neighbour onto idx costs idx's terrain
+        int enter = dist + cellCost(grid[idx]);
+        for (int i = 0; i < 4; i++) {
+            int prev = idx + grid.neighborOffset(i);
+            if (grid.isOpen(prev) && (field[prev] == UNREACHABLE || enter < field[prev])) {
+                field[prev] = enter;
+                queue.push(static_cast<uint64_t>(prev), enter);
+            }
+        }
+    }
+}
+
+void KeySolver::prepare(const MazeGrid& grid, int goalRow, int goalCol) {
+    placedKeys = 0;
+    goalIndex = -1;
+    goalField.clear();
+    keyCellIndex.clear();
+    if (!grid.inBounds(goalRow, goalCol)) {
+        return;
+    }
+    
+    goalIndex = grid.index(goalRow, goalCol);
+    buildField(grid, vector<int>(1, goalIndex), goalField);
+    
+    // Key cells that cannot reach the goal never help finish a route
+    vector<int> keyCells[MAX_KEY_TYPES];
+    for (int idx = 0; idx < grid.getCellCount(); idx++) {
+        int type = keyType(grid[idx]);
+        if (type >= 0) {
+            keyCellIndex.push_back(idx);
+        }
+        if (type >= 0 && goalField[idx] != UNREACHABLE) {
+            keyCells[type].push_back(idx);
+        }
+    }
+    
+    for (int type = 0; type < MAX_KEY_TYPES; type++) {
+        keyToGoal[type] = UNREACHABLE;
+        keyFields[type].clear();
+        if (keyCells[type].empty()) {
+            continue;
+        }
+        placedKeys |= 1u << type;
+        for (int idx : keyCells[type]) {
+            if (keyToGoal[type] == UNREACHABLE || goalField[idx] < keyToGoal[type]) {
+                keyToGoal[type] = goalField[idx];
+            }
+        }
+        buildField(grid, keyCells[type], keyFields[type]);
+    }
+    
+    // keyToKey[a][b]: cheapest walk from any key a onto any key b
+    for (int a = 0; a < MAX_KEY_TYPES; a++) {
+        for (int b = 0; b < MAX_KEY_TYPES; b++) {
+            keyToKey[a][b] = UNREACHABLE;
+            if (a == b || keyCells[a].empty() || keyCells[b].empty()) {
+                continue;
+            }
+            for (int idx : keyCells[a]) {
+                int dist = keyFields[b][idx];
+                if (dist != UNREACHABLE && (keyToKey[a][b] == UNREACHABLE || dist < keyToKey[a][b])) {
+                    keyToKey[a][b] = dist;
+                }
+            }
+        }
+    }
+}
+
+// Lower bound on the remaining cost from idx: the goal must still be
+// reached, every missing key must be visited first, and any two missing
+// keys must both be visited in one order or the other. Returns UNREACHABLE
+// when no completion exists even with every door open.
+int KeySolver::heuristic(int idx, unsigned missing) const {
+    int bound = goalField[idx];
+    if (bound == UNREACHABLE) {
+        return UNREACHABLE;
+    }
+    
+    int toKey[MAX_KEY_TYPES];
+    for (int a = 0; a < MAX_KEY_TYPES; a++) {
+        if (!(missing >> a & 1)) {
+            continue;
+        }
+        toKey[a] = keyFields[a][idx];
+        if (toKey[a] == UNREACHABLE) {
+            return UNREACHABLE;
+        }
+        bound = max(bound, toKey[a] + keyToGoal[a]);
+        
+        for (int b = 0; b < a; b++) {
+            if ((missing >> b & 1) && keyToKey[a][b] != UNREACHABLE) {
+                int viaA = toKey[a] + keyToKey[a][b] + keyToGoal[b];
+                int viaB = toKey[b] + keyToKey[b][a] + keyToGoal[a];
+                bound = max(bound, min(viaA, viaB));
+            }
+        }
+    }
+    return bound;
+}
+
+void KeySolver::touchMask(unsigned mask, size_t cellCount) {
+    size_t words = (cellCount + 63) / 64;
+    size_t parentWords = (cellCount + 31) / 32;
+    size_t pickupWords = (keyCellIndex.size() + 63) / 64;
+    if (settled[mask].size() != words || parents[mask].size() != parentWords) {
+        settled[mask].assign(words, 0);
+        parents[mask].assign(parentWords, 0);
+    }
+    if (pickups[mask].size() != pickupWords) {
+        pickups[mask].assign(pickupWords, 0);
+    }
+    maskReady[mask] = true;
+    touchedMasks.push_back(mask);
+}
+
+// Position of a key cell in keyCellIndex
+size_t KeySolver::keyOrdinal(int idx) const {
+    return static_cast<size_t>(lower_bound(keyCellIndex.begin(), keyCellIndex.end(), idx) - keyCellIndex.begin());
+}
+
+bool KeySolver::solve(const MazeGrid& grid, int startRow, int startCol, unsigned startKeys,
+                      unsigned requiredKeys, vector<Cell>& path, int& cost, SolveStats& stats) {
+    path.clear();
+    stats = SolveStats();
+    cost = -1;
+    
+    size_t cellCount = static_cast<size_t>(grid.getCellCount());
+    if (!grid.inBounds(startRow, startCol) || goalField.size() != cellCount) {
+        return false;
+    }
+    
+    Clock timer;
+    unsigned allKeys = (1u << MAX_KEY_TYPES) - 1;
+    startKeys &= allKeys;
+    requiredKeys &= allKeys;
+    if ((requiredKeys & ~startKeys & ~placedKeys) != 0) {
+        return false;  // A required key is missing from the grid
+    }
+    
+    // Only the masks touched by the previous search hold stale bits
+    for (unsigned mask : touchedMasks) {
+        fill(settled[mask].begin(), settled[mask].end(), 0);
+        maskReady[mask] = false;
+    }
+    touchedMasks.clear();
+    
+    // Entry layout: state = mask * cellCount + idx, shifted left past the parent code
+    auto pushState = [&](unsigned mask, int idx, uint8_t code, int key) {
+        uint64_t state = static_cast<uint64_t>(mask) * cellCount + static_cast<uint64_t>(idx);
+        queue.push((state << CODE_BITS) | code, key);
+    };
+    
+    // Queue keys are f = g + h, offset by the start's h so they begin at 0.
+    // A step adds its terrain cost to g and moves h by at most one terrain
+    // cost either way, so f never jumps more than twice MAX_CELL_COST.
+    int start = grid.index(startRow, startCol);
+    int startBound = heuristic(start, requiredKeys & ~startKeys);
+    if (startBound == UNREACHABLE) {
+        stats.milliseconds = timer.getElapsedTime().asMicroseconds() / 1000.f;
+        return false;
+    }
+    queue.reset(2 * MAX_CELL_COST);
+    pushState(startKeys, start, 0, 0);
+    
+    unsigned goalMask = 0;
+    bool found = false;
+    
+    while (!queue.empty()) {
+        int key;
+        uint64_t entry = queue.pop(key);
+        uint8_t code = static_cast<uint8_t>(entry & ((1u << CODE_BITS) - 1));
+        uint64_t state = entry >> CODE_BITS;
+        unsigned mask = static_cast<unsigned>(state / cellCount);
+        int idx = static_cast<int>(state % cellCount);
+        
+        if (!maskReady[mask]) {
+            touchMask(mask, cellCount);
+        }
+        uint64_t& word = settled[mask][idx >> 6];
+        uint64_t bit = uint64_t(1) << (idx & 63);
+        if (word & bit) {
+            continue;  // Already settled at a lower or equal cost
+        }
+        word |= bit;
+        writeDirection(parents[mask], idx, code >> 1);
+        if (keyType(grid[idx]) >= 0) {
+            size_t ordinal = keyOrdinal(idx);
+            uint64_t pickupBit = uint64_t(1) << (ordinal & 63);
+            uint64_t& pickupWord = pickups[mask][ordinal >> 6];
+            pickupWord = (code & 1) ? (pickupWord | pickupBit) : (pickupWord & ~pickupBit);
+        }
+        stats.nodesExpanded++;
+        
+        // Recover g from f
+        int bound = heuristic(idx, requiredKeys & ~mask);
+        int g = key + startBound - bound;
+        if (idx == goalIndex && (mask & requiredKeys) == requiredKeys) {
+            goalMask = mask;
+            cost = g;
+            found = true;
+            break;
+        }
+        
+        for (int i = 0; i < 4; i++) {
+            int next = idx + grid.neighborOffset(i);
+            char cell = grid[next];
+            if (cell == '#') {
+                continue;
+            }
+            
+            int door = doorType(cell);
+            if (door >= 0 && !(mask & (1u << door))) {
+                continue;  // Locked
+            }
+            
+            unsigned nextMask = mask;
+            int keyIndex = keyType(cell);
+            bool pickup = keyIndex >= 0 && !(mask & (1u << keyIndex));
+            if (pickup) {
+                nextMask |= 1u << keyIndex;
+            }
+            
+            if (maskReady[nextMask] && (settled[nextMask][next >> 6] >> (next & 63)) & 1) {
+                continue;
+            }
+            int nextBound = heuristic(next, requiredKeys & ~nextMask);
+            if (nextBound == UNREACHABLE) {
+                continue;  // Cannot finish from here even with every door open
+            }
+            int nextKey = g + cellCost(cell) + nextBound - startBound;
+            pushState(nextMask, next, parentCode(i, pickup), nextKey);
+        }
+    }
+    
+    if (found) {
+        // Follow parent directions back to the start state: count the steps
+        // first, then fill the path from the goal backwards
+        auto stepBack = [&](unsigned& mask, int& idx) {
+            int dir = readDirection(parents[mask], idx);
+            int type = keyType(grid[idx]);
+            if (type >= 0) {
+                size_t ordinal = keyOrdinal(idx);
+                if ((pickups[mask][ordinal >> 6] >> (ordinal & 63)) & 1) {
+                    mask &= ~(1u << type);
+                }
+            }
+            idx -= grid.neighborOffset(dir);
+        };
+        
+        int length = 0;
+        unsigned mask = goalMask;
+        int idx = goalIndex;
+        while (idx != start || mask != startKeys) {
+            stepBack(mask, idx);
+            length++;
+        }
+        
+        path.resize(length + 1);
+        mask = goalMask;
+        idx = goalIndex;
+        for (int step = length; step >= 0; step--) {
+            path[step] = Cell(grid.rowOf(idx), grid.colOf(idx), step);
+            if (step > 0) {
+                stepBack(mask, idx);
+            }
+        }
+    }
+    
+    stats.milliseconds = timer.getElapsedTime().asMicroseconds() / 1000.f;
+    return found;
+}
@@ -0,0 +1,68 @@
+/*
+ * KeySolver.hpp - Shortest path over (cell, collected keys) states
+ */
+
+#ifndef KEYSOLVER_HPP
+#define KEYSOLVER_HPP
+
+#include "Common.hpp"
+#include "MazeGrid.hpp"
+#include "PathSolver.hpp"
+#include "BucketQueue.hpp"
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Searches the product space of cells and key bitmasks: walking onto a key
+// cell adds its bit, and a door can only be entered while its key is held.
+// The goal counts as reached once all 'requiredKeys' are held.
+//
+// States are expanded in A* order through a bucket queue. The heuristic is
+// the largest of "reach the goal" and, for every key still missing, "reach
+// that key, then the goal", measured on door-less terrain distance fields
+// built once per level by prepare(); it is consistent, so a state is final
+// the first time it is popped. Each key mask gets its own settled bitset
+// and a 2-bit parent direction per cell, allocated the first time a state
+// with that mask is reached, so an 8-key maze only pays for the masks a
+// search actually touches and never hashes states. Whether a key was picked
+// up on entering a cell is only ambiguous on key cells, so that flag gets
+// one bit per key cell rather than per cell.
+class KeySolver {
+private:
+    vector<vector<uint64_t>> settled;   // [mask] -> one bit per cell
+    vector<vector<uint64_t>> parents;   // [mask] -> 2-bit direction into each cell
+    vector<vector<uint64_t>> pickups;   // [mask] -> one bit per entry of keyCellIndex
+    vector<int> keyCellIndex;           // Every key cell, ascending
+    vector<char> maskReady;             // Mask bitset cleared for the current search
+    vector<unsigned> touchedMasks;      // Masks whose bitsets need clearing
+    BucketQueue queue;
+    
+    // Heuristic fields from prepare()
+    vector<int> goalField;              // Cost from each cell to the goal
+    vector<vector<int>> keyFields;      // [type] -> cost to the nearest key of that type
+    int keyToGoal[MAX_KEY_TYPES];       // Cheapest key-to-goal cost per type
+    int keyToKey[MAX_KEY_TYPES][MAX_KEY_TYPES];
+    int goalIndex;
+    unsigned placedKeys;                // Key types that can reach the goal
+    
+    void touchMask(unsigned mask, size_t cellCount);
+    size_t keyOrdinal(int idx) const;
+    void buildField(const MazeGrid& grid, const vector<int>& targets, vector<int>& field);
+    int heuristic(int idx, unsigned missing) const;
+    
+public:
+    KeySolver();
+    
+    // Build the heuristic fields for a grid and goal; call again whenever
+    // walls or key positions change (picking keys up does not matter)
+    void prepare(const MazeGrid& grid, int goalRow, int goalCol);
+    
+    // Cheapest route from 'start' holding 'startKeys' to the prepared goal
+    // holding at least 'requiredKeys'. 'cost' receives the summed cellCost;
+    // 'path' follows the usual start-to-goal contract.
+    bool solve(const MazeGrid& grid, int startRow, int startCol, unsigned startKeys,
+               unsigned requiredKeys, vector<Cell>& path, int& cost, SolveStats& stats);
+};
+
+#endif // KEYSOLVER_HPP
@@ -0,0 +1,54 @@
+/*
+ * Label.cpp - Retained text element implementation
+ */
+
+#include "Label.hpp"
+
+using namespace std;
+using namespace sf;
+
+Label::Label(const Font& font, const string& value, unsigned characterSize, Color color, uint32_t style)
+    : text(font, value, characterSize),
+      content(value),
+      anchored(false),
+      layoutDirty(false) {
+    text.setFillColor(color);
+    text.setStyle(style);
+}
+
+void Label::setString(const string& value) {
+    if (value == content) {
+        return;
+    }
+    content = value;
+    text.setString(content);
+    layoutDirty = anchored;
+}
+
+void Label::setAnchor(Vector2f fraction) {
+    anchor = fraction;
+    anchored = true;
+    layoutDirty = true;
+}
+
+void Label::layout() {
+    if (!layoutDirty) {
+        return;
+    }
+    FloatRect bounds = text.getLocalBounds();
+    text.setOrigin(Vector2f(
+        bounds.position.x + bounds.size.x * anchor.x,
+        bounds.position.y + bounds.size.y * anchor.y
+    ));
+    layoutDirty = false;
+}
+
+FloatRect Label::getBounds() {
+    layout();
+    return text.getLocalBounds();
+}
+
+void Label::draw(RenderTarget& target) {
+    layout();
+    target.draw(text);
+}
@@ -0,0 +1,53 @@
+/*
+ * Label.hpp - Retained text element for screens
+ */
+
+#ifndef LABEL_HPP
+#define LABEL_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+
+using namespace std;
+using namespace sf;
+
+// An sf::Text that is created once and kept. sf::Text lays its glyphs out
+// lazily and keeps the quads until the string or style changes, so a label
+// whose content stays the same is drawn straight from cached vertices.
+// setString() compares against the current content first and does nothing
+// when it matches, which lets screens call it every frame.
+//
+// With an anchor set, the label's origin is that fraction of its bounds
+// (0.5, 0.5 centres it on its position) and is recomputed only when the
+// content changes. Layout waits until the next draw or getBounds(), so
+// labels can be built before their font is loaded.
+class Label {
+private:
+    Text text;
+    string content;
+    Vector2f anchor;
+    bool anchored;
+    bool layoutDirty;
+
+    void layout();
+
+public:
+    Label(const Font& font, const string& value, unsigned characterSize, Color color,
+          uint32_t style = Text::Style::Regular);
+
+    void setString(const string& value);
+    const string& getString() const { return content; }
+
+    // Origin at 'fraction' of the text bounds, e.g. (0.5, 0.5) for centred
+    void setAnchor(Vector2f fraction);
+    void setPosition(Vector2f position) { text.setPosition(position); }
+    void setColor(Color color) { text.setFillColor(color); }
+
+    // Local bounds of the laid-out text
+    FloatRect getBounds();
+
+    void draw(RenderTarget& target);
+};
+
+#endif // LABEL_HPP
@@ -5,13 +5,64 @@
 #include "LevelScreen.hpp"
 #include "Common.hpp"
 #include <SFML/Graphics.hpp>
-#include <tuple>
-
 using namespace std;
 using namespace sf;
 
+namespace {
+    // Level data: difficulty name, color, description lines
+    struct LevelInfo {
+        const char* difficulty;
+        Color color;
+        vector<string> description;
+    };
+    
+    const LevelInfo LEVEL_INFO[] = {
+        {"EASY", Color(100, 200, 100), {"Simple maze layout", "Perfect for beginners"}},
+        {"MEDIUM", Color(200, 180, 100), {"Complex pathfinding", "More challenging"}},
+        {"HARD", Color(200, 100, 100), {"Dynamic generation", "Complex maze", "Expert level"}}
+    };
+}
+
+LevelScreen::LevelCard::LevelCard(const Font& font, int level)
+    : number(font, to_string(level), 32, Color::White, Text::Style::Bold),
+      difficulty(font, LEVEL_INFO[level - 1].difficulty, 22, LEVEL_INFO[level - 1].color, Text::Style::Bold),
+      keyPrompt(font, "Press " + to_string(level), 18, Color(150, 180, 200), Text::Style::Italic) {
+    number.setAnchor(Vector2f(0.5f, 0.5f));
+    difficulty.setAnchor(Vector2f(0.5f, 0.5f));
+    keyPrompt.setAnchor(Vector2f(0.5f, 0.5f));
+    for (const string& line : LEVEL_INFO[level - 1].description) {
+        description.emplace_back(font, line, 16, Color(180, 200, 220));
+        description.back().setAnchor(Vector2f(0.5f, 0.5f));
+    }
+}
+
 LevelScreen::LevelScreen(RenderWindow* win, Font* f, const string& name)
-    : ScreenBase(win, f), playerName(name), selectedLevel(0) {
+    : ScreenBase(win, f),
+      playerName(name),
+      gameTitle(*f, "ALGOMAZE", 56, Color(50, 200, 100), Text::Style::Bold),
+      playerGreeting(*f, "", 28, Color(200, 220, 255), Text::Style::Bold),
+      subtitle(*f, "Choose Your Challenge", 24, Color(180, 200, 220)),
+      instructionText(*f, "Select a level to begin your journey", 20, Color(150, 180, 200), Text::Style::Italic),
+      hintText(*f, "Tip: Press 4 to explore the endless world", 16, Color(100, 120, 140)),
+      selectedLevel(0) {
+    gameTitle.setAnchor(Vector2f(0.5f, 0.5f));
+    playerGreeting.setAnchor(Vector2f(0.5f, 0.5f));
+    subtitle.setAnchor(Vector2f(0.5f, 0.5f));
+    instructionText.setAnchor(Vector2f(0.5f, 0.5f));
+    hintText.setAnchor(Vector2f(0.5f, 0.5f));
+    for (int level = 1; level <= 3; level++) {
+        cards.emplace_back(*f, level);
+    }
+}
+
+void LevelScreen::setGenerating(bool generating) {
+    instructionText.setString(generating ? "Generating level..." : "Select a level to begin your journey");
+    instructionText.setColor(Color(150, 180, 200));
+}
+
+void LevelScreen::setBuildFailed() {
+    instructionText.setString("Not enough memory for this level size");
+    instructionText.setColor(Color(220, 100, 100));
 }
 
 void LevelScreen::draw() {
@@ -38,39 +89,20 @@ void LevelScreen::draw() {
     }
     
     // Draw game title
-    Text gameTitle(*font, "ALGOMAZE", 56);
-    gameTitle.setFillColor(Color(50, 200, 100));
-    gameTitle.setStyle(Text::Style::Bold);
-    FloatRect titleBounds = gameTitle.getLocalBounds();
-    gameTitle.setOrigin(Vector2f(
-        titleBounds.position.x + titleBounds.size.x / 2.f,
-        titleBounds.position.y + titleBounds.size.y / 2.f
-    ));
     gameTitle.setPosition(Vector2f(size.x / 2.f, 80.f));
-    window->draw(gameTitle);
+    gameTitle.draw(*window);
     
-    // Display player name
-    Text playerGreeting(*font, "Welcome, " + playerName + "!", 28);
-    playerGreeting.setFillColor(Color(200, 220, 255));
-    playerGreeting.setStyle(Text::Style::Bold);
-    FloatRect greetingBounds = playerGreeting.getLocalBounds();
-    playerGreeting.setOrigin(Vector2f(
-        greetingBounds.position.x + greetingBounds.size.x / 2.f,
-        greetingBounds.position.y + greetingBounds.size.y / 2.f
-    ));
+    // Display player name, greeted again only if it changed
+    if (greetedName != playerName) {
+        greetedName = playerName;
+        playerGreeting.setString("Welcome, " + playerName + "!");
+    }
     playerGreeting.setPosition(Vector2f(size.x / 2.f, 140.f));
-    window->draw(playerGreeting);
+    playerGreeting.draw(*window);
     
     // Draw subtitle
-    Text subtitle(*font, "Choose Your Challenge", 24);
-    subtitle.setFillColor(Color(180, 200, 220));
-    FloatRect subtitleBounds = subtitle.getLocalBounds();
-    subtitle.setOrigin(Vector2f(
-        subtitleBounds.position.x + subtitleBounds.size.x / 2.f,
-        subtitleBounds.position.y + subtitleBounds.size.y / 2.f
-    ));
     subtitle.setPosition(Vector2f(size.x / 2.f, 180.f));
-    window->draw(subtitle);
+    subtitle.draw(*window);
     
     // Level card dimensions
     float cardWidth = 280.f;
@@ -80,13 +112,6 @@ void LevelScreen::draw() {
     float startX = size.x / 2.f - totalWidth / 2.f;
     float cardY = size.y / 2.f - 20.f;
     
-    // Level data: [difficulty name, color, description]
-    vector<tuple<string, Color, string>> levelData = {
-        {"EASY", Color(100, 200, 100), "Simple maze layout\nPerfect for beginners"},
-        {"MEDIUM", Color(200, 180, 100), "Complex pathfinding\nMore challenging"},
-        {"HARD", Color(200, 100, 100), "Dynamic generation\nComplex maze\nExpert level"}
-    };
-    
     // Draw level selection cards
     for (int i = 0; i < 3; i++) {
         float cardX = startX + i * (cardWidth + cardSpacing);
@@ -101,7 +126,7 @@ void LevelScreen::draw() {
         RectangleShape card(Vector2f(cardWidth, cardHeight));
         card.setFillColor(Color(25, 30, 40));
         card.setOutlineThickness(2.f);
-        auto levelColor = get<1>(levelData[i]);
+        Color levelColor = LEVEL_INFO[i].color;
         card.setOutlineColor(levelColor);
         card.setPosition(Vector2f(cardX, cardY));
         window->draw(card);
@@ -120,89 +145,35 @@ void LevelScreen::draw() {
         badge.setPosition(Vector2f(cardX + cardWidth / 2.f - 25.f, cardY + 15.f));
         window->draw(badge);
         
-        Text levelNum(*font, to_string(i + 1), 32);
-        levelNum.setFillColor(Color::White);
-        levelNum.setStyle(Text::Style::Bold);
-        FloatRect numBounds = levelNum.getLocalBounds();
-        levelNum.setOrigin(Vector2f(
-            numBounds.position.x + numBounds.size.x / 2.f,
-            numBounds.position.y + numBounds.size.y / 2.f
-        ));
-        levelNum.setPosition(Vector2f(cardX + cardWidth / 2.f, cardY + 40.f));
-        window->draw(levelNum);
+        LevelCard& levelCard = cards[i];
+        levelCard.number.setPosition(Vector2f(cardX + cardWidth / 2.f, cardY + 40.f));
+        levelCard.number.draw(*window);
         
         // Difficulty name
-        Text difficultyText(*font, get<0>(levelData[i]), 22);
-        difficultyText.setFillColor(levelColor);
-        difficultyText.setStyle(Text::Style::Bold);
-        FloatRect diffBounds = difficultyText.getLocalBounds();
-        difficultyText.setOrigin(Vector2f(
-            diffBounds.position.x + diffBounds.size.x / 2.f,
-            diffBounds.position.y + diffBounds.size.y / 2.f
-        ));
-        difficultyText.setPosition(Vector2f(cardX + cardWidth / 2.f, cardY + 85.f));
-        window->draw(difficultyText);
+        levelCard.difficulty.setPosition(Vector2f(cardX + cardWidth / 2.f, cardY + 85.f));
+        levelCard.difficulty.draw(*window);
         
-        // Description (split into lines)
-        string desc = get<2>(levelData[i]);
-        vector<string> descLines;
-        size_t pos = 0;
-        while ((pos = desc.find('\n')) != string::npos) {
-            descLines.push_back(desc.substr(0, pos));
-            desc = desc.substr(pos + 1);
-        }
-        descLines.push_back(desc);
-        
-        for (size_t j = 0; j < descLines.size(); j++) {
-            Text descText(*font, descLines[j], 16);
-            descText.setFillColor(Color(180, 200, 220));
-            FloatRect descBounds = descText.getLocalBounds();
-            descText.setOrigin(Vector2f(
-                descBounds.position.x + descBounds.size.x / 2.f,
-                descBounds.position.y + descBounds.size.y / 2.f
-            ));
-            descText.setPosition(Vector2f(
+        // Description, one label per line
+        for (size_t j = 0; j < levelCard.description.size(); j++) {
+            levelCard.description[j].setPosition(Vector2f(
                 cardX + cardWidth / 2.f,
                 cardY + 115.f + j * 22.f
             ));
-            window->draw(descText);
+            levelCard.description[j].draw(*window);
         }
         
         // Key number indicator
-        Text keyPrompt(*font, "Press " + to_string(i + 1), 18);
-        keyPrompt.setFillColor(Color(150, 180, 200));
-        keyPrompt.setStyle(Text::Style::Italic);
-        FloatRect keyPromptBounds = keyPrompt.getLocalBounds();
-        keyPrompt.setOrigin(Vector2f(
-            keyPromptBounds.position.x + keyPromptBounds.size.x / 2.f,
-            keyPromptBounds.position.y + keyPromptBounds.size.y / 2.f
-        ));
-        keyPrompt.setPosition(Vector2f(cardX + cardWidth / 2.f, cardY + cardHeight + 15.f));
-        window->draw(keyPrompt);
+        levelCard.keyPrompt.setPosition(Vector2f(cardX + cardWidth / 2.f, cardY + cardHeight + 15.f));
+        levelCard.keyPrompt.draw(*window);
     }
     
     // Draw instruction text at bottom
-    Text instructionText(*font, "Select a level to begin your journey", 20);
-    instructionText.setFillColor(Color(150, 180, 200));
-    instructionText.setStyle(Text::Style::Italic);
-    FloatRect instructionBounds = instructionText.getLocalBounds();
-    instructionText.setOrigin(Vector2f(
-        instructionBounds.position.x + instructionBounds.size.x / 2.f,
-        instructionBounds.position.y + instructionBounds.size.y / 2.f
-    ));
     instructionText.setPosition(Vector2f(size.x / 2.f, size.y - 80.f));
-    window->draw(instructionText);
+    instructionText.draw(*window);
     
     // Draw hint text
-    Text hintText(*font, "Tip: You can change level anytime with keys 1-3", 16);
-    hintText.setFillColor(Color(100, 120, 140));
-    FloatRect hintBounds = hintText.getLocalBounds();
-    hintText.setOrigin(Vector2f(
-        hintBounds.position.x + hintBounds.size.x / 2.f,
-        hintBounds.position.y + hintBounds.size.y / 2.f
-    ));
     hintText.setPosition(Vector2f(size.x / 2.f, size.y - 50.f));
-    window->draw(hintText);
+    hintText.draw(*window);
     
     // Draw decorative bottom border
     RectangleShape bottomBorder(Vector2f(static_cast<float>(size.x), 4.f));
@@ -227,6 +198,10 @@ optional<GameState> LevelScreen::handleInput(const Event& event) {
                 selectedLevel = 3;
                 return GameState::GAMEPLAY;
             }
+            if (keyEvent->code == Keyboard::Key::Num4 || keyEvent->code == Keyboard::Key::Numpad4) {
+                selectedLevel = ENDLESS_LEVEL;
+                return GameState::GAMEPLAY;
+            }
         }
     }
     return nullopt;
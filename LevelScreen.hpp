@@ -8,9 +8,11 @@
 
 #include "ScreenBase.hpp"
 #include "GameState.hpp"
+#include "Label.hpp"
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <optional>
+#include <vector>
 
 using namespace std;
 using namespace sf;
@@ -19,14 +21,38 @@ class LevelScreen : public ScreenBase {
 private:
     const string& playerName;  // Reference to player name
     
+    // Text of one level card, built once
+    struct LevelCard {
+        Label number;
+        Label difficulty;
+        vector<Label> description;
+        Label keyPrompt;
+        
+        LevelCard(const Font& font, int level);
+    };
+    
+    Label gameTitle;
+    Label playerGreeting;
+    string greetedName;        // Name playerGreeting was last built for
+    Label subtitle;
+    vector<LevelCard> cards;
+    Label instructionText;
+    Label hintText;
+    
 public:
     LevelScreen(RenderWindow* win, Font* f, const string& name);
     void draw() override;
     optional<GameState> handleInput(const Event& event) override;
     
-    // Returns selected level (1-3) when level is selected
+    // Returns selected level (1-3, or ENDLESS_LEVEL) when level is selected
     int getSelectedLevel() const { return selectedLevel; }
     
+    // Swap the instruction line for a notice while a level is being built
+    void setGenerating(bool generating);
+    
+    // Swap the instruction line for a notice that the level could not be built
+    void setBuildFailed();
+    
 private:
     int selectedLevel = 0;  // 0 means no selection yet
 };
@@ -4,22 +4,91 @@
 
 #include "Maze.hpp"
 #include "Common.hpp"
+#include "Random.hpp"
 #include <algorithm>
-#include <random>
+#include <cstring>
 #include <ctime>
 
 using namespace std;
 using namespace sf;
 
+namespace {
+    // Mixed into the level seed so decorations don't replay the carving stream
+    const uint64_t DECORATION_STREAM = 0x6A09E667F3BCC909ULL;
+    
+    // Share of the non-tree walls removed from the generated level
+    const float LEVEL_LOOP_DENSITY = 0.25f;
+    
+    // Level 3 should make the player work a little: a solution at least a
+    // quarter longer than the straight-line distance and a few dead ends
+    // to back out of. About one random maze in eight qualifies.
+    DifficultyTarget levelDifficulty() {
+        DifficultyTarget target;
+        target.minDetour = 1.25f;
+        target.maxDetour = 2.5f;
+        target.minDeadEndRatio = 0.03f;
+        return target;
+    }
+    
+    // Rooms sit on odd coordinates inside the wall ring and the goal on the
+    // last room, (rows - 2, cols - 2), so Level 3 sides are rounded up to
+    // odd; an even side would leave the goal walled in
+    GeneratorConfig levelShape(GeneratorConfig config) {
+        config.rows |= 1;
+        config.cols |= 1;
+        return config;
+    }
+    
+    // Endless mode window, slid to re-centre on the player whenever they
+    // come within EDGE_MARGIN cells of its edge. The margin is wider than
+    // half the screen at normal zoom, so the camera keeps following the
+    // player smoothly and a slide never shows.
+    const int ENDLESS_ROWS = 256;
+    const int ENDLESS_COLS = 256;
+    const int EDGE_MARGIN = 64;
+    
+    // Chunks around the player built ahead of time in endless mode
+    const int PREFETCH_RADIUS = 1;
+    
+    // Goal field layers kept at most, one per set of held keys (two key types)
+    const int MAX_GOAL_LAYERS = 4;
+    
+    // Larger levels skip the difficulty search: it generates and measures
+    // several whole candidates per level, which at millions of cells costs
+    // more time and memory than the level itself. The first maze is kept.
+    const int64_t DIFFICULTY_SEARCH_MAX_CELLS = 1 << 22;
+}
+
 Maze::Maze() 
-    : currentLevel(1),
-      gameWon(false),
-      hasKey(false),
+    : gameWon(false),
+      currentLevel(1),
+      levelSeed(0),
+      pregenPool(nullptr),
+      endless(false),
+      windowRow(0),
+      windowCol(0),
+      levelRevision(0),
       stepsTaken(0),
-      lastPlayerRow(-1),
-      lastPlayerCol(-1),
+      costTaken(0),
+      goalLayers(0),
+      heldKeys(0),
+      requiredKeys(0),
+      keyGated(false),
+      keyRouteCell(-1),
+      keyRouteKeys(0),
+      keyRouteFound(false),
+      keyRouteCost(-1),
+      routeCell(-1),
+      routeKeys(0),
+      routeCheckpoints(0),
+      routeFound(false),
       lastMoveTime(0),
-      cachedPath(nullopt) {
+      moveDelay(MOVE_DELAY_MS) {
+    
+    // About a quarter of the spare walls: 10-15 loops at the default 15x21
+    generatorConfig = levelShape(generatorConfig);
+    generatorConfig.loopDensity = LEVEL_LOOP_DENSITY;
+    difficultyTarget = levelDifficulty();
     
     // Initialize predefined level layouts
     levels = {
@@ -64,269 +133,689 @@ Maze::Maze()
     loadLevel(currentLevel);
 }
 
-void Maze::generateDFSMaze(int mazeRows, int mazeCols) {
-    // Initialize maze with all walls
-    maze.assign(mazeRows, vector<char>(mazeCols, '#'));
-    
-    // Stack for recursive backtracking
-    vector<pair<int, int>> stack;
-    
-    // Visited cells tracking
-    vector<vector<bool>> visited(mazeRows, vector<bool>(mazeCols, false));
-    
-    // Random number generator
-    static random_device rd;
-    static mt19937 gen(rd());
-    
-    // Start from a random cell (must be odd row/col for proper maze structure)
-    int startR = 1;
-    int startC = 1;
-    
-    // Mark start as visited and push to stack
-    visited[startR][startC] = true;
-    maze[startR][startC] = '.';
-    stack.push_back({startR, startC});
-    
-    // Recursive backtracking algorithm
-    while (!stack.empty()) {
-        pair<int, int> current = stack.back();
-        int r = current.first;
-        int c = current.second;
-        
-        // Find unvisited neighbors (cells 2 steps away)
-        vector<pair<int, int>> neighbors;
-        
-        // Check all 4 directions
-        for (int i = 0; i < 4; i++) {
-            int nr = r + dx[i] * 2;  // 2 steps away
-            int nc = c + dy[i] * 2;
-            
-            // Check if neighbor is valid and unvisited
-            if (nr >= 1 && nr < mazeRows - 1 && nc >= 1 && nc < mazeCols - 1 && !visited[nr][nc]) {
-                neighbors.push_back({nr, nc});
-            }
-        }
-        
-        if (!neighbors.empty()) {
-            // Choose random neighbor
-            uniform_int_distribution<> dis(0, neighbors.size() - 1);
-            int choice = dis(gen);
-            pair<int, int> next = neighbors[choice];
-            int nextR = next.first;
-            int nextC = next.second;
-            
-            // Determine direction
-            int dir = 0;
-            if (nextR > r) dir = 1;      // Down
-            else if (nextR < r) dir = 0; // Up
-            else if (nextC > c) dir = 3; // Right
-            else if (nextC < c) dir = 2; // Left
-            
-            // Carve the wall cell
-            int midR = r + dx[dir];
-            int midC = c + dy[dir];
-            maze[midR][midC] = '.';
-            
-            // Mark next as visited and carve path
-            visited[nextR][nextC] = true;
-            maze[nextR][nextC] = '.';
-            
-            // Push next to stack
-            stack.push_back({nextR, nextC});
-        } else {
-            // No unvisited neighbors, backtrack
-            stack.pop_back();
-        }
-    }
-    
-    // Ensure border walls remain
-    for (int r = 0; r < mazeRows; r++) {
-        maze[r][0] = '#';
-        maze[r][mazeCols - 1] = '#';
-    }
-    for (int c = 0; c < mazeCols; c++) {
-        maze[0][c] = '#';
-        maze[mazeRows - 1][c] = '#';
-    }
-}
-
 void Maze::loadLevel(int level) {
+    if (level == ENDLESS_LEVEL) {
+        loadEndless();
+        return;
+    }
+    endless = false;
     if (levels.empty()) {
         return;
     }
-
+    
     int index = max(1, min(level, static_cast<int>(levels.size()))) - 1;
     currentLevel = index + 1;
-
+    
     // Special handling for Level 3: Generate using DFS algorithm
     if (level == 3) {
-        rows = 15;
-        cols = 20;
+        // A level built in the background only needs swapping in
+        if (pregenPool) {
+            unique_ptr<Maze> built = pregenPool->take(generatorConfig, difficultyTarget);
+            if (built) {
+                adoptLevel(*built);
+                pregenPool->recycle(move(built));
+                resetProgress();
+                markLevelChanged();
+                return;
+            }
+        }
         
-        // Generate the maze using recursive backtracking
-        generateDFSMaze(rows, cols);
+        // A configured seed is built exactly. Otherwise search candidates
+        // from a fresh seed for one that meets the difficulty target; the
+        // seed kept is the winning candidate's, so the level can still be
+        // rebuilt exactly. Candidates are generated as configured: recursive
+        // backtracking with a share of the spare walls knocked out for loops.
+        // Levels too large to search take the first maze from a fresh seed.
+        if (generatorConfig.seed != 0) {
+            levelSeed = generatorConfig.seed;
+            generator.generate(generatorConfig, maze);
+        } else if (static_cast<int64_t>(generatorConfig.rows) * generatorConfig.cols > DIFFICULTY_SEARCH_MAX_CELLS) {
+            GeneratorConfig config = generatorConfig;
+            config.seed = levelSeed = randomSeed();
+            generator.generate(config, maze);
+        } else {
+            GeneratorConfig config = generatorConfig;
+            config.seed = randomSeed();
+            levelSeed = difficultySearch.search(config, difficultyTarget, maze).seed;
+        }
+        rows = maze.getRows();
+        cols = maze.getCols();
         
-        // Random number generator for wall removal
-        static random_device rd;
-        static mt19937 gen(rd());
-        uniform_int_distribution<> rowDist(1, rows - 2);
-        uniform_int_distribution<> colDist(1, cols - 2);
+        // Mud and items draw from their own stream of the same seed
+        Rng rng(levelSeed ^ DECORATION_STREAM);
+        
+        // Set start and goal positions far apart
+        playerRow = 1;
+        playerCol = 1;
+        goalRow = rows - 2;
+        goalCol = cols - 2;
         
-        // Remove 10-15 random walls between path cells to create loops
-        uniform_int_distribution<> loopCount(10, 15);
-        int numLoops = loopCount(gen);
+        // Scatter a few mud patches over the corridors
+        int numPatches = rng.range(3, 5);
         
-        for (int i = 0; i < numLoops; i++) {
+        for (int i = 0; i < numPatches; i++) {
             int attempts = 0;
-            bool found = false;
+            bool placed = false;
             
-            // Try to find a wall that separates two path cells
-            while (!found && attempts < 100) {
-                int r = rowDist(gen);
-                int c = colDist(gen);
+            while (!placed && attempts < 100) {
+                int r = rng.range(1, rows - 2);
+                int c = rng.range(1, cols - 2);
                 
-                // Check if it's a wall
-                if (maze[r][c] == '#') {
-                    // Check if this wall separates two path cells
-                    // Check horizontal neighbors (left and right)
-                    if (c >= 2 && c < cols - 2) {
-                        if (maze[r][c - 1] == '.' && maze[r][c + 1] == '.') {
-                            maze[r][c] = '.';  // Remove wall to create horizontal loop
-                            found = true;
-                        }
-                    }
-                    
-                    // Check vertical neighbors (up and down) if horizontal didn't work
-                    if (!found && r >= 2 && r < rows - 2) {
-                        if (maze[r - 1][c] == '.' && maze[r + 1][c] == '.') {
-                            maze[r][c] = '.';  // Remove wall to create vertical loop
-                            found = true;
+                if (maze.at(r, c) == '.') {
+                    // Mud spreads into the open cells around the seed cell
+                    maze.at(r, c) = '~';
+                    for (int d = 0; d < 4; d++) {
+                        if (maze.at(r + dx[d], c + dy[d]) == '.') {
+                            maze.at(r + dx[d], c + dy[d]) = '~';
                         }
                     }
+                    placed = true;
                 }
                 attempts++;
             }
         }
         
-        // Set start and goal positions far apart
-        playerRow = 1;
-        playerCol = 1;
-        goalRow = rows - 2;
-        goalCol = cols - 2;
-        
         // Ensure start and goal are paths
-        maze[playerRow][playerCol] = '.';
-        maze[goalRow][goalCol] = '.';
+        maze.at(playerRow, playerCol) = '.';
+        maze.at(goalRow, goalCol) = '.';
+        
+        // Lock every way into the goal behind door 'Q'
+        int goal = maze.index(goalRow, goalCol);
+        for (int d = 0; d < 4; d++) {
+            int next = goal + maze.neighborOffset(d);
+            if (maze.isOpen(next)) {
+                maze[next] = 'Q';
+            }
+        }
+        
+        // Flood the cells the player can reach with the door still shut.
+        // computeGoalDistances() refills the goal fields below, so until
+        // then they hold the flood's marks and queue rather than two more
+        // arrays the size of the grid.
+        vector<int>& seen = goalSteps;
+        seen.assign(maze.getCellCount(), 0);
+        goalDistance.resize(maze.getCellCount());
+        int* reachable = goalDistance.data();
+        size_t head = 0, tail = 0;
+        int start = maze.index(playerRow, playerCol);
+        seen[start] = 1;
+        reachable[tail++] = start;
+        while (head < tail) {
+            int current = reachable[head++];
+            for (int d = 0; d < 4; d++) {
+                int next = current + maze.neighborOffset(d);
+                if (maze.isOpen(next) && doorType(maze[next]) < 0 && !seen[next]) {
+                    seen[next] = 1;
+                    reachable[tail++] = next;
+                }
+            }
+        }
+        
+        // Hide key 'q' on that side, away from both start and goal. A maze
+        // too small to keep the spread falls back to any reachable cell.
+        int minSpread = (rows + cols) / 3;
+        bool keyPlaced = false;
+        for (int attempts = 0; attempts < 2000 && !keyPlaced; attempts++) {
+            int r = rng.range(1, rows - 2);
+            int c = rng.range(1, cols - 2);
+            int fromStart = abs(r - playerRow) + abs(c - playerCol);
+            int fromGoal = abs(r - goalRow) + abs(c - goalCol);
+            bool spread = attempts >= 1000 || (fromStart >= minSpread && fromGoal >= minSpread);
+            
+            if (maze.at(r, c) == '.' && spread && seen[maze.index(r, c)] &&
+                !(r == playerRow && c == playerCol)) {
+                maze.at(r, c) = 'q';
+                keyPlaced = true;
+            }
+        }
+        
+        // Random probes can all miss when few cells are open on the start's
+        // side, so walk the flood itself, farthest from the start first: a
+        // spread path cell if there is one, else any floor but the start,
+        // mud included
+        for (int pass = 0; pass < 2 && !keyPlaced; pass++) {
+            for (size_t i = tail - 1; i > 0 && !keyPlaced; i--) {
+                int r = maze.rowOf(reachable[i]);
+                int c = maze.colOf(reachable[i]);
+                int fromStart = abs(r - playerRow) + abs(c - playerCol);
+                int fromGoal = abs(r - goalRow) + abs(c - goalCol);
+                bool spread = pass == 1 || (fromStart >= minSpread && fromGoal >= minSpread);
+                char cell = maze[reachable[i]];
+                if ((cell == '.' || (pass == 1 && cell == '~')) && spread) {
+                    maze[reachable[i]] = 'q';
+                    keyPlaced = true;
+                }
+            }
+        }
+        
+        // No cell to hide the key in: take the doors away again rather
+        // than lock the goal out of reach
+        if (!keyPlaced) {
+            for (int d = 0; d < 4; d++) {
+                int next = goal + maze.neighborOffset(d);
+                if (doorType(maze[next]) >= 0) {
+                    maze[next] = '.';
+                }
+            }
+        }
+        
+        // Optional checkpoints for players who want to tour them all
+        const int numCheckpoints = 3;
+        for (int i = 0, attempts = 0; i < numCheckpoints && attempts < 1000; attempts++) {
+            int r = rng.range(1, rows - 2);
+            int c = rng.range(1, cols - 2);
+            bool isEndpoint = (r == playerRow && c == playerCol) || (r == goalRow && c == goalCol);
+            
+            if (maze.at(r, c) == '.' && !isEndpoint) {
+                maze.at(r, c) = '*';
+                i++;
+            }
+        }
         
     } else {
         // Levels 1 and 2 use hardcoded layouts
         const auto& data = levels[index];
-
+        
         rows = static_cast<int>(data.layout.size());
         cols = rows > 0 ? static_cast<int>(data.layout[0].size()) : 0;
-
-        maze.assign(rows, vector<char>(cols, '#'));
+        
+        maze.assign(rows, cols, '#');
         for (int r = 0; r < rows; ++r) {
             for (int c = 0; c < cols; ++c) {
-                maze[r][c] = data.layout[r][c];
+                maze.at(r, c) = data.layout[r][c];
             }
         }
-
+        
         playerRow = data.startRow;
         playerCol = data.startCol;
         goalRow = data.goalRow;
         goalCol = data.goalCol;
     }
+    
+    resetProgress();
+    
+    // The grid only holds terrain; the player is tracked by position so
+    // mud under the player is never overwritten
+    if (goalRow >= 0 && goalRow < rows && goalCol >= 0 && goalCol < cols) {
+        maze.at(goalRow, goalCol) = 'G';
+    }
+    
+    // The goal is fixed for the whole level, so solve once from the goal side
+    scanWaypoints();
+    computeGoalDistances();
+    markLevelChanged();
+}
+
+bool Maze::isLevelReady(int level) {
+    if (level != 3 || !pregenPool || generatorConfig.seed != 0) {
+        return true;
+    }
+    // Stocking again brings back a shelf dropped for newer configurations
+    pregenPool->stock(generatorConfig, difficultyTarget);
+    return pregenPool->readyCount(generatorConfig, difficultyTarget) > 0;
+}
+
+bool Maze::isLevelFailed(int level) {
+    if (level != 3 || !pregenPool || generatorConfig.seed != 0) {
+        return false;
+    }
+    return pregenPool->hasFailed(generatorConfig, difficultyTarget);
+}
+
+void Maze::setGeneratorConfig(const GeneratorConfig& config) {
+    generatorConfig = levelShape(config);
+    if (pregenPool) {
+        pregenPool->stock(generatorConfig, difficultyTarget);
+    }
+}
+
+void Maze::setDifficultyTarget(const DifficultyTarget& target) {
+    difficultyTarget = target;
+    if (pregenPool) {
+        pregenPool->stock(generatorConfig, difficultyTarget);
+    }
+}
 
+void Maze::setPregenPool(MazePool* pool) {
+    pregenPool = pool;
+    if (pregenPool) {
+        pregenPool->stock(generatorConfig, difficultyTarget);
+    }
+}
+
+void Maze::adoptLevel(Maze& built) {
+    // Everything loadLevel derives from the grid moves over with it; the
+    // old buffers go back in 'built' for the pool to reuse
+    swap(maze, built.maze);
+    swap(rows, built.rows);
+    swap(cols, built.cols);
+    playerRow = built.playerRow;
+    playerCol = built.playerCol;
+    goalRow = built.goalRow;
+    goalCol = built.goalCol;
+    levelSeed = built.levelSeed;
+    goalDistance.swap(built.goalDistance);
+    goalSteps.swap(built.goalSteps);
+    goalLayers = built.goalLayers;
+    requiredKeys = built.requiredKeys;
+    keyGated = built.keyGated;
+    swap(keySolver, built.keySolver);
+    checkpoints.swap(built.checkpoints);
+    keyCells.swap(built.keyCells);
+    swap(routeOptimizer, built.routeOptimizer);
+}
+
+void Maze::resetProgress() {
     gameWon = false;
-    hasKey = false;
+    heldKeys = 0;
     stepsTaken = 0;
-    lastPlayerRow = playerRow;
-    lastPlayerCol = playerCol;
-    cachedPath = nullopt;
+    costTaken = 0;
+    moveDelay = MOVE_DELAY_MS;
+    keyRouteCell = -1;
+    routeCell = -1;
     gameClock.restart();
+}
+
+void Maze::loadEndless() {
+    endless = true;
+    currentLevel = ENDLESS_LEVEL;
+    levelSeed = generatorConfig.seed != 0 ? generatorConfig.seed : randomSeed();
+    world.reset(levelSeed);
+    
+    // Start on a room in the middle of chunk (0, 0); there is no goal
+    rows = ENDLESS_ROWS;
+    cols = ENDLESS_COLS;
+    windowRow = 0;
+    windowCol = 0;
+    playerRow = ChunkWorld::CHUNK_SIZE / 2 + 1;
+    playerCol = ChunkWorld::CHUNK_SIZE / 2 + 1;
+    goalRow = -1;
+    goalCol = -1;
+    
+    // Centre the window on the player and copy it out of the world
+    windowRow = playerRow - rows / 2;
+    windowCol = playerCol - cols / 2;
+    playerRow = rows / 2;
+    playerCol = cols / 2;
+    maze.assign(rows, cols, '#');
+    readWorld(0, rows, 0, cols);
+    world.prefetch(getWorldRow(), getWorldCol(), PREFETCH_RADIUS);
+    
+    // No goal, so computeGoalDistances() leaves its fields empty; slides
+    // keep the grid size, so this is done once
+    scanWaypoints();
+    computeGoalDistances();
+    markLevelChanged();
+    resetProgress();
+}
 
-    if (playerRow >= 0 && playerRow < rows && playerCol >= 0 && playerCol < cols) {
-        maze[playerRow][playerCol] = 'P';
+void Maze::moveWindow() {
+    // Re-centre on the player: every cell moves by the same shift, at most
+    // half the window since the player is still inside it
+    int shiftRow = playerRow - rows / 2;
+    int shiftCol = playerCol - cols / 2;
+    windowRow += shiftRow;
+    windowCol += shiftCol;
+    playerRow -= shiftRow;
+    playerCol -= shiftCol;
+    
+    // Cells still inside the window move over within the grid, walking
+    // away from the side they move towards so nothing is overwritten early;
+    // only the strips that scrolled in are read from the world
+    int keepCols = cols - abs(shiftCol);
+    int fromCol = max(shiftCol, 0);
+    int toCol = max(-shiftCol, 0);
+    for (int i = 0; i < rows - abs(shiftRow); i++) {
+        int r = shiftRow >= 0 ? i : rows - 1 - i;
+        memmove(&maze.at(r, toCol), &maze.at(r + shiftRow, fromCol), keepCols);
     }
-    if (goalRow >= 0 && goalRow < rows && goalCol >= 0 && goalCol < cols) {
-        maze[goalRow][goalCol] = 'G';
+    if (shiftRow > 0) {
+        readWorld(rows - shiftRow, rows, 0, cols);
+    } else if (shiftRow < 0) {
+        readWorld(0, -shiftRow, 0, cols);
+    }
+    int keepFirst = max(0, -shiftRow);
+    int keepEnd = rows - max(0, shiftRow);
+    if (shiftCol > 0) {
+        readWorld(keepFirst, keepEnd, cols - shiftCol, cols);
+    } else if (shiftCol < 0) {
+        readWorld(keepFirst, keepEnd, 0, -shiftCol);
+    }
+    
+    // Logged edits move with their cells
+    for (Cell& changed : cellChanges) {
+        changed.row -= shiftRow;
+        changed.col -= shiftCol;
     }
+    world.prefetch(getWorldRow(), getWorldCol(), PREFETCH_RADIUS);
 }
 
-bool Maze::isValidCell(int row, int col) {
-    if (row < 0 || row >= rows || col < 0 || col >= cols) {
-        return false;
+void Maze::readWorld(int firstRow, int endRow, int firstCol, int endCol) {
+    for (int r = firstRow; r < endRow; r++) {
+        for (int c = firstCol; c < endCol; c++) {
+            maze.at(r, c) = world.at(windowRow + r, windowCol + c);
+        }
+    }
+}
+
+void Maze::markLevelChanged() {
+    levelRevision++;
+    cellChanges.clear();
+}
+
+void Maze::setCell(int row, int col, char value) {
+    maze.at(row, col) = value;
+    cellChanges.push_back(Cell(row, col, 0));
+}
+
+void Maze::scanWaypoints() {
+    requiredKeys = 0;
+    keyGated = false;
+    keyRouteCell = -1;
+    routeCell = -1;
+    checkpoints.clear();
+    keyCells.clear();
+    
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            char cell = maze.at(r, c);
+            if (keyType(cell) >= 0) {
+                requiredKeys |= 1u << keyType(cell);
+                keyCells.push_back(Cell(r, c, 0));
+                keyGated = true;
+            } else if (doorType(cell) >= 0) {
+                keyGated = true;
+            } else if (cell == '*') {
+                checkpoints.push_back(Cell(r, c, 0));
+            }
+        }
+    }
+    
+    // A few key types get a goal field layer per set of held keys (see
+    // computeGoalDistances); more would multiply the fields, so those
+    // levels search (cell, keys) states on each move instead
+    int keyTypes = 0;
+    for (int type = 0; type < MAX_KEY_TYPES; type++) {
+        keyTypes += (requiredKeys >> type) & 1;
     }
-    if (maze[row][col] == '#') {
-        return false;  // Wall is blocking
+    goalLayers = 1 << keyTypes;
+    if (goalLayers > MAX_GOAL_LAYERS) {
+        goalLayers = 0;
+        keySolver.prepare(maze, goalRow, goalCol);
     }
-    // Allow '.' (PATH), 'G' (GOAL), 'P' (PLAYER) cells
-    return true;
+    
+    // The tour's searches run once here; a move only looks them up. Levels
+    // whose fields would not fit the optimizer's budget go without.
+    vector<Cell> waypoints;
+    collectWaypoints(waypoints);
+    SolveStats stats;
+    routeOptimizer.prepare(maze, waypoints, goalRow, goalCol, heldKeys, stats);
+}
+
+bool Maze::updateKeyRoute() const {
+    int current = maze.index(playerRow, playerCol);
+    if (current != keyRouteCell || heldKeys != keyRouteKeys) {
+        SolveStats stats;
+        keyRouteFound = keySolver.solve(
+            maze, playerRow, playerCol, heldKeys, requiredKeys,
+            keyRoute, keyRouteCost, stats);
+        keyRouteCell = current;
+        keyRouteKeys = heldKeys;
+    }
+    return keyRouteFound;
+}
+
+void Maze::collectWaypoints(vector<Cell>& waypoints) const {
+    waypoints = checkpoints;
+    waypoints.insert(waypoints.end(), keyCells.begin(), keyCells.end());
+}
+
+unsigned Maze::remainingWaypoints() const {
+    // Reached checkpoints and picked-up keys turn back into path, and a key
+    // of a type already held is not worth the detour
+    const vector<Cell>& waypoints = routeOptimizer.getWaypoints();
+    unsigned remaining = 0;
+    for (size_t i = 0; i < waypoints.size(); i++) {
+        char cell = maze.at(waypoints[i].row, waypoints[i].col);
+        int type = keyType(cell);
+        if (cell == '*' || (type >= 0 && !hasKey(type))) {
+            remaining |= 1u << i;
+        }
+    }
+    return remaining;
+}
+
+bool Maze::hasWaypoints() const {
+    return !checkpoints.empty() || (requiredKeys & ~heldKeys) != 0;
+}
+
+bool Maze::tracksRoute() const {
+    return routeOptimizer.isPrepared();
 }
 
-optional<vector<Cell>> Maze::findShortestPath() {
-    queue<Cell> q;
-    vector<vector<bool>> visited(rows, vector<bool>(cols, false));
-    vector<vector<Cell>> parent(rows, vector<Cell>(cols, Cell(-1, -1, -1)));
+optional<RoutePlan> Maze::findOptimalRoute() const {
+    if (!maze.inBounds(playerRow, playerCol) || !tracksRoute()) {
+        return nullopt;
+    }
     
-    // Safety check for invalid dimensions
-    if (rows <= 0 || cols <= 0 || playerRow < 0 || playerRow >= rows || 
-        playerCol < 0 || playerCol >= cols || goalRow < 0 || goalRow >= rows || 
-        goalCol < 0 || goalCol >= cols) {
+    int current = maze.index(playerRow, playerCol);
+    if (current != routeCell || heldKeys != routeKeys || checkpoints.size() != routeCheckpoints) {
+        routeFound = routeOptimizer.solve(maze, playerRow, playerCol, remainingWaypoints(),
+                                          route, routeStats);
+        routeCell = current;
+        routeKeys = heldKeys;
+        routeCheckpoints = checkpoints.size();
+    }
+    
+    if (!routeFound) {
         return nullopt;
     }
+    return route;
+}
+
+bool Maze::isValidCell(int row, int col) {
+    // The grid's sentinel border turns out-of-range neighbours into walls, so
+    // only coordinates more than one cell outside the maze need rejecting
+    if (row < -1 || row > rows || col < -1 || col > cols) {
+        return false;
+    }
+    // Allow '.' (PATH), '~' (MUD), 'G' (GOAL) cells
+    return maze.isOpen(maze.index(row, col));
+}
+
+void Maze::computeGoalDistances() {
+    // Without a goal (endless mode) the fields stay empty; too many key
+    // types leave them to keySolver
+    if (!maze.inBounds(goalRow, goalCol) || goalLayers == 0) {
+        goalDistance.clear();
+        goalSteps.clear();
+        return;
+    }
+    size_t cellCount = static_cast<size_t>(maze.getCellCount());
+    goalDistance.assign(goalLayers * cellCount, -1);
+    goalSteps.assign(goalLayers * cellCount, -1);
+    
+    // Keys held in each layer; layers number the subsets of requiredKeys
+    unsigned layerKeys[MAX_GOAL_LAYERS] = {};
+    for (int layer = 0; layer < goalLayers; layer++) {
+        for (int type = 0, bit = 0; type < MAX_KEY_TYPES; type++) {
+            if ((requiredKeys >> type) & 1) {
+                layerKeys[layer] |= ((layer >> bit++) & 1u) << type;
+            }
+        }
+    }
+    
+    // Reverse Dijkstra from the goal: a route through cell v pays cellCost(v)
+    // on entering it. Costs are small integers, so the workspace's bucket
+    // queue replaces a binary heap; the distance array is the visited set.
+    //
+    // States are (layer, cell), packed as layer << 32 | idx. Only the layer
+    // holding every key ends at the goal. Doors open in the layers holding
+    // their key. Standing on a key means holding it, so a key cell's value
+    // passes down unchanged to the layer without that key; a move into it
+    // from that layer is never relaxed directly.
+    BucketQueue& queue = workspace.bucketQueue();
+    queue.reset(MAX_CELL_COST);
     
-    q.push(Cell(playerRow, playerCol, 0));
-    visited[playerRow][playerCol] = true;
-    parent[playerRow][playerCol] = Cell(-1, -1, -1);
+    size_t goal = goalState(maze.index(goalRow, goalCol), requiredKeys);
+    goalDistance[goal] = 0;
+    goalSteps[goal] = 0;
+    queue.push(goal / cellCount << 32 | goal % cellCount, 0);
     
-    while (!q.empty()) {
-        Cell current = q.front();
-        q.pop();
+    while (!queue.empty()) {
+        int cost;
+        uint64_t entry = queue.pop(cost);
+        int layer = static_cast<int>(entry >> 32);
+        int current = static_cast<int>(entry & 0xFFFFFFFFu);
+        size_t state = layer * cellCount + current;
+        if (cost != goalDistance[state]) {
+            continue;  // Stale entry
+        }
+        unsigned keys = layerKeys[layer];
         
-        if (current.row == goalRow && current.col == goalCol) {
-            // Goal found - backtrack to build the path
-            vector<Cell> path;
-            Cell backtrack = current;
-            int maxPathLength = rows * cols;
-            int pathLength = 0;
-            
-            while (backtrack.row != -1 && backtrack.col != -1 && pathLength < maxPathLength) {
-                path.push_back(backtrack);
-                Cell next = parent[backtrack.row][backtrack.col];
-                
-                if (next.row == -1 && next.col == -1) {
-                    break;
-                }
-                
-                backtrack = next;
-                pathLength++;
+        int type = keyType(maze[current]);
+        if (type >= 0 && ((keys >> type) & 1)) {
+            size_t without = goalState(current, keys & ~(1u << type));
+            if (goalDistance[without] == -1 || cost < goalDistance[without]) {
+                goalDistance[without] = cost;
+                goalSteps[without] = goalSteps[state];
+                queue.push(without / cellCount << 32 | current, cost);
             }
-            
-            reverse(path.begin(), path.end());
-            return path;
         }
         
+        int nextCost = cost + maze.cost(current);
+        
+        // No bounds checks needed: the border sentinel is never open
         for (int i = 0; i < 4; i++) {
-            int newRow = current.row + dx[i];
-            int newCol = current.col + dy[i];
-            
-            if (isValidCell(newRow, newCol) && !visited[newRow][newCol]) {
-                visited[newRow][newCol] = true;
-                parent[newRow][newCol] = current;
-                q.push(Cell(newRow, newCol, current.distance + 1));
+            int next = current + maze.neighborOffset(i);
+            char cell = maze[next];
+            if (!maze.isOpen(next) || (doorType(cell) >= 0 && !((keys >> doorType(cell)) & 1)) ||
+                (keyType(cell) >= 0 && !((keys >> keyType(cell)) & 1))) {
+                continue;
+            }
+            size_t nextState = state + (next - current);
+            if (goalDistance[nextState] == -1 || nextCost < goalDistance[nextState]) {
+                goalDistance[nextState] = nextCost;
+                goalSteps[nextState] = goalSteps[state] + 1;
+                queue.push(static_cast<uint64_t>(layer) << 32 | next, nextCost);
             }
         }
     }
+}
+
+size_t Maze::goalState(int idx, unsigned keys) const {
+    // The layer packs the held bits of requiredKeys, lowest type first
+    int layer = 0;
+    for (int type = 0, bit = 0; type < MAX_KEY_TYPES; type++) {
+        if ((requiredKeys >> type) & 1) {
+            layer |= ((keys >> type) & 1) << bit++;
+        }
+    }
+    return static_cast<size_t>(layer) * maze.getCellCount() + idx;
+}
+
+optional<int> Maze::getShortestPathLength() const {
+    if (!maze.inBounds(playerRow, playerCol)) {
+        return nullopt;
+    }
+    if (searchesKeyRoutes()) {
+        return updateKeyRoute() ? optional<int>(static_cast<int>(keyRoute.size()) - 1) : nullopt;
+    }
+    if (goalSteps.empty()) {
+        return nullopt;
+    }
+    
+    int steps = goalSteps[goalState(maze.index(playerRow, playerCol), heldKeys)];
+    if (steps < 0) {
+        return nullopt;
+    }
+    return steps;
+}
+
+optional<int> Maze::getShortestPathCost() const {
+    if (!maze.inBounds(playerRow, playerCol)) {
+        return nullopt;
+    }
+    if (searchesKeyRoutes()) {
+        return updateKeyRoute() ? optional<int>(keyRouteCost) : nullopt;
+    }
+    if (goalDistance.empty()) {
+        return nullopt;
+    }
+    
+    int cost = goalDistance[goalState(maze.index(playerRow, playerCol), heldKeys)];
+    if (cost < 0) {
+        return nullopt;
+    }
+    return cost;
+}
+
+optional<Cell> Maze::getNextBestStep() const {
+    optional<int> steps = getShortestPathLength();
+    if (!steps.has_value() || steps.value() == 0) {
+        return nullopt;
+    }
+    
+    if (searchesKeyRoutes()) {
+        return keyRoute[1];
+    }
+    
+    unsigned keys = heldKeys;
+    int next = nextStepTowardGoal(maze.index(playerRow, playerCol), keys);
+    return Cell(maze.rowOf(next), maze.colOf(next), goalSteps[goalState(next, keys)]);
+}
+
+int Maze::nextStepTowardGoal(int idx, unsigned& keys) const {
+    // A neighbour v continues the cheapest route if entering it accounts for
+    // exactly the cost difference and it is one step closer along the route.
+    // Entering a key cell picks the key up, so v is read in that layer.
+    size_t state = goalState(idx, keys);
+    for (int i = 0; i < 4; i++) {
+        int next = idx + maze.neighborOffset(i);
+        char cell = maze[next];
+        if (!maze.isOpen(next) || (doorType(cell) >= 0 && !((keys >> doorType(cell)) & 1))) {
+            continue;
+        }
+        unsigned nextKeys = keyType(cell) >= 0 ? keys | 1u << keyType(cell) : keys;
+        size_t nextState = goalState(next, nextKeys);
+        if (goalDistance[nextState] >= 0 &&
+            goalDistance[nextState] + maze.cost(next) == goalDistance[state] &&
+            goalSteps[nextState] == goalSteps[state] - 1) {
+            keys = nextKeys;
+            return next;
+        }
+    }
+    return idx;
+}
+
+optional<vector<Cell>> Maze::findShortestPath() const {
+    optional<int> steps = getShortestPathLength();
+    if (!steps.has_value()) {
+        return nullopt;
+    }
+    if (searchesKeyRoutes()) {
+        return keyRoute;
+    }
+    
+    // Greedy descent over the distance field, O(path) cells
+    vector<Cell> path;
+    path.reserve(steps.value() + 1);
+    
+    int current = maze.index(playerRow, playerCol);
+    unsigned keys = heldKeys;
+    path.push_back(Cell(playerRow, playerCol, 0));
+    
+    for (int step = 1; step <= steps.value(); step++) {
+        current = nextStepTowardGoal(current, keys);
+        path.push_back(Cell(maze.rowOf(current), maze.colOf(current), step));
+    }
     
-    return nullopt;
+    return path;
 }
 
 bool Maze::movePlayer(int direction) {
-    // Check if we can move (basic movement delay)
+    // Check if we can move; the delay grows with the cost of the last cell entered
     int currentTime = static_cast<int>(movementClock.getElapsedTime().asMilliseconds());
-    int moveDelay = 50;
     
     if (currentTime - lastMoveTime < moveDelay) {
         return false;
@@ -339,29 +828,50 @@ bool Maze::movePlayer(int direction) {
         return false;
     }
     
-    // Clear old player position
-    char oldCell = maze[playerRow][playerCol];
-    if (oldCell == 'G') {
-        maze[playerRow][playerCol] = 'G';
-    } else {
-        maze[playerRow][playerCol] = '.';
+    // Doors only open for a player holding the matching key
+    char target = maze.at(newRow, newCol);
+    if (doorType(target) >= 0 && !hasKey(doorType(target))) {
+        return false;
     }
     
     // Update player position
     playerRow = newRow;
     playerCol = newCol;
     
-    // Check if player reached the goal
-    if (maze[playerRow][playerCol] == 'G') {
+    // Pick up keys; the cell turns into plain path
+    if (keyType(target) >= 0) {
+        heldKeys |= 1u << keyType(target);
+        setCell(playerRow, playerCol, '.');
+    }
+    
+    // Checkpoints count once and then turn into plain path
+    if (target == '*') {
+        setCell(playerRow, playerCol, '.');
+        for (size_t i = 0; i < checkpoints.size(); i++) {
+            if (checkpoints[i].row == playerRow && checkpoints[i].col == playerCol) {
+                checkpoints.erase(checkpoints.begin() + i);
+                break;
+            }
+        }
+    }
+    
+    // Check if player reached the goal with every key it needs
+    if (target == 'G' && (heldKeys & requiredKeys) == requiredKeys) {
         gameWon = true;
-        maze[playerRow][playerCol] = 'P';
-    } else {
-        maze[playerRow][playerCol] = 'P';
     }
     
+    // Wading through mud costs more and slows the next move down
+    int cost = cellCost(target);
+    costTaken += cost;
+    moveDelay = MOVE_DELAY_MS * cost;
+    
     lastMoveTime = currentTime;
     stepsTaken++;
-    cachedPath = nullopt;
+    
+    // Slide the endless window before the player reaches its edge
+    if (endless && (playerRow < EDGE_MARGIN || playerRow >= rows - EDGE_MARGIN ||
+                    playerCol < EDGE_MARGIN || playerCol >= cols - EDGE_MARGIN)) {
+        moveWindow();
+    }
     return true;
 }
-
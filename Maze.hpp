@@ -6,7 +6,17 @@
 #define MAZE_HPP
 
 #include "Common.hpp"
+#include "MazeGrid.hpp"
+#include "SolverWorkspace.hpp"
+#include "PathSolver.hpp"
+#include "KeySolver.hpp"
+#include "RouteOptimizer.hpp"
+#include "MazeGenerator.hpp"
+#include "DifficultySearch.hpp"
+#include "MazePool.hpp"
+#include "ChunkWorld.hpp"
 #include <SFML/Graphics.hpp>
+#include <memory>
 #include <queue>
 #include <optional>
 #include <vector>
@@ -16,39 +26,157 @@ using namespace sf;
 
 class Maze {
 private:
-    vector<vector<char>> maze;        // 2D grid representing the maze
+    MazeGrid maze;                    // Flat grid representing the maze
     int rows, cols;                   // Dimensions of the maze
     int playerRow, playerCol;         // Player's current position
     int goalRow, goalCol;            // Goal position
     bool gameWon;                     // Game state flag
     int currentLevel;                 // Selected level index (1-based)
     vector<LevelDefinition> levels;   // Predefined level layouts
+    MazeGenerator generator;          // Builds the Level 3 maze
+    GeneratorConfig generatorConfig;  // Level 3 dimensions (15x21 by default, always odd) and seed
+    uint64_t levelSeed;               // Seed the current Level 3 was built from
+    DifficultySearch difficultySearch; // Picks an unseeded Level 3 that meets difficultyTarget
+    DifficultyTarget difficultyTarget;
+    MazePool* pregenPool;             // Source of pre-built Level 3s (optional, not owned)
+    
+    // Endless mode: the grid is a window onto an unbounded chunked world,
+    // slid along with the player
+    ChunkWorld world;
+    bool endless;
+    int64_t windowRow, windowCol;     // World position of grid cell (0, 0)
+    
+    // Change tracking for renderers: the revision moves whenever the whole
+    // grid is replaced; single cells edited in place since then are logged.
+    // Sliding the endless window is neither: renderers follow the window
+    // origin and shift what they hold.
+    unsigned levelRevision;
+    vector<Cell> cellChanges;
     
     Clock gameClock;                   // Game timer
     int stepsTaken;                    // Number of steps taken
-    optional<vector<Cell>> cachedPath;  // Cached shortest path
-    int lastPlayerRow, lastPlayerCol;   // Track player position for cache invalidation
+    int costTaken;                     // Terrain cost of every cell entered so far
+    
+    // Cheapest cost to the goal (-1 = unreachable) and the steps along that
+    // route, per cell, in one layer per set of held keys: entry
+    // [layer * cellCount + idx], see goalState()
+    vector<int> goalDistance;
+    vector<int> goalSteps;
+    int goalLayers;                    // Layers in the fields (0 = keySolver answers instead)
+    SolverWorkspace workspace;         // Scratch buffers reused by every search
+    
+    // Keys and doors
+    unsigned heldKeys;                 // Bitmask of collected key types
+    unsigned requiredKeys;             // Keys the goal needs (every key placed in the level)
+    bool keyGated;                     // Level has keys or doors
+    mutable KeySolver keySolver;       // (cell, keys) search, for levels with too many key types to layer
+    
+    // Key-gated route from the player's current state, cached until it changes
+    mutable int keyRouteCell;
+    mutable unsigned keyRouteKeys;
+    mutable bool keyRouteFound;
+    mutable int keyRouteCost;
+    mutable vector<Cell> keyRoute;
+    
+    // Waypoints: optional checkpoints ('*') and the keys still to collect
+    vector<Cell> checkpoints;          // Checkpoints not yet reached
+    vector<Cell> keyCells;             // Where each key was placed
+    RouteOptimizer routeOptimizer;     // Prepared with every waypoint at load
     
-    // Game state
-    bool hasKey;                       // Player has collected the key
+    // Optimal waypoint route from the player's current state, cached like keyRoute
+    mutable int routeCell;
+    mutable unsigned routeKeys;
+    mutable size_t routeCheckpoints;
+    mutable bool routeFound;
+    mutable RoutePlan route;
+    mutable SolveStats routeStats;
     
     // Movement timing
     Clock movementClock;               // Clock to track movement timing
     int lastMoveTime;                  // Last time player moved (ms)
+    int moveDelay;                     // Delay before the next move (ms), longer in mud
     
     // Private helper methods
-    void generateDFSMaze(int mazeRows, int mazeCols);
     bool isValidCell(int row, int col);
+    void computeGoalDistances();
+    size_t goalState(int idx, unsigned keys) const;
+    bool searchesKeyRoutes() const { return keyGated && goalLayers == 0; }
+    int nextStepTowardGoal(int idx, unsigned& keys) const;
+    void scanWaypoints();
+    void collectWaypoints(vector<Cell>& waypoints) const;
+    unsigned remainingWaypoints() const;
+    bool updateKeyRoute() const;
+    void adoptLevel(Maze& built);
+    void resetProgress();
+    void loadEndless();
+    void moveWindow();
+    void readWorld(int firstRow, int endRow, int firstCol, int endCol);
+    void markLevelChanged();
+    void setCell(int row, int col, char value);
     
 public:
     Maze();
     
     // Level management
     void loadLevel(int level);
+    
+    // False while loadLevel(level) would have to search for an unseeded
+    // Level 3 itself because the pool has none ready yet; callers on the
+    // UI thread poll this instead of stalling a frame
+    bool isLevelReady(int level);
+    
+    // True if the pool ran out of memory building this level; it will
+    // never become ready, so callers stop waiting and report it
+    bool isLevelFailed(int level);
+    
+    // Settings for the generated level; applied on the next loadLevel(3).
+    // Even sides are rounded up to odd.
+    void setGeneratorConfig(const GeneratorConfig& config);
+    const GeneratorConfig& getGeneratorConfig() const { return generatorConfig; }
+    
+    // Bounds an unseeded Level 3 is searched for (a seeded one is built as
+    // is); applied on the next loadLevel(3)
+    void setDifficultyTarget(const DifficultyTarget& target);
+    const DifficultyTarget& getDifficultyTarget() const { return difficultyTarget; }
+    
+    // Seed of the last generated level (0 before any); putting it in the
+    // config rebuilds that level byte for byte
+    uint64_t getLevelSeed() const { return levelSeed; }
+    
+    // Take Level 3 from 'pool' when it has one ready for the current config
+    // and difficulty target, and keep the pool stocked for them (nullptr =
+    // always build)
+    void setPregenPool(MazePool* pool);
+    
     int getCurrentLevel() const { return currentLevel; }
     
+    // Endless mode (loadLevel(ENDLESS_LEVEL)): there is no goal; the world
+    // position is the player's cell in world coordinates
+    bool isEndless() const { return endless; }
+    int64_t getWorldRow() const { return windowRow + playerRow; }
+    int64_t getWorldCol() const { return windowCol + playerCol; }
+    const ChunkWorld& getWorld() const { return world; }
+    
+    // World position of grid cell (0, 0). Only endless mode moves it: grid
+    // cell (r, c) then holds what cell (r + d.row, c + d.col) held before a
+    // slide by d.
+    int64_t getWindowRow() const { return windowRow; }
+    int64_t getWindowCol() const { return windowCol; }
+    
+    // Endless mode: take in chunks finished in the background since the
+    // last call, so the cache counters are current
+    void collectBuiltChunks() { world.collectFinished(); }
+    
+    // Revision of the grid; a change means every cell may differ
+    unsigned getLevelRevision() const { return levelRevision; }
+    
+    // Cells changed in place since the revision last moved, oldest first,
+    // in current grid coordinates (a window slide shifts them too, possibly
+    // off the grid). Consumers remember how many entries they have applied.
+    const vector<Cell>& getCellChanges() const { return cellChanges; }
+    
     // Game state getters
-    const vector<vector<char>>& getMazeData() const { return maze; }
+    MazeGridView getMazeData() const { return maze.view(); }
     int getRows() const { return rows; }
     int getCols() const { return cols; }
     int getPlayerRow() const { return playerRow; }
@@ -56,12 +184,41 @@ public:
     int getGoalRow() const { return goalRow; }
     int getGoalCol() const { return goalCol; }
     int getStepsTaken() const { return stepsTaken; }
+    int getCostTaken() const { return costTaken; }
     float getElapsedTime() const { return gameClock.getElapsedTime().asSeconds(); }
     bool isGameWon() const { return gameWon; }
+    unsigned getHeldKeys() const { return heldKeys; }
+    unsigned getRequiredKeys() const { return requiredKeys; }
+    bool hasKey(int type) const { return (heldKeys >> type) & 1; }
+    bool isKeyGated() const { return keyGated; }
+    int getCheckpointsLeft() const { return static_cast<int>(checkpoints.size()); }
+    bool hasWaypoints() const;
+    
+    // False on levels too large to keep the waypoint tour's cost fields
+    // (RouteOptimizer::FIELD_BUDGET); findOptimalRoute() then has nothing
+    bool tracksRoute() const;
     
     // Game logic
     bool movePlayer(int direction);
-    optional<vector<Cell>> findShortestPath();
+    optional<vector<Cell>> findShortestPath() const;
+    
+    // Cheapest tour from the player through every remaining checkpoint and
+    // missing key, then the goal, in the best order. Checkpoints are
+    // optional, so the shortest path readouts below leave them out. The
+    // searches behind it run once per level; a move costs a lookup per
+    // remaining waypoint, redone only when the player's state changes.
+    optional<RoutePlan> findOptimalRoute() const;
+    const SolveStats& getRouteStats() const { return routeStats; }
+    
+    // Distance field lookups (O(1), valid for the current level). The field
+    // holds the cheapest route by terrain cost; its length is in steps.
+    // Keys add a layer per set of held keys, so the fields cost 8 bytes per
+    // cell per layer, filled once at load. Levels with more than two key
+    // types answer from a (cell, keys) search instead, re-run only when
+    // the player's position or keys change.
+    optional<int> getShortestPathLength() const;
+    optional<int> getShortestPathCost() const;
+    optional<Cell> getNextBestStep() const;
 };
 
 #endif // MAZE_HPP
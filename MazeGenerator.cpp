@@ -0,0 +1,372 @@
+/*
+ * MazeGenerator.cpp - Perfect maze generation implementation
+ */
+
+#include "MazeGenerator.hpp"
+#include "Common.hpp"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+    // Mixed into a configured seed for the loop stream
+    const uint64_t LOOP_STREAM = 0xBB67AE8584CAA73BULL;
+}
+
+MazeGenerator::MazeGenerator(ThreadPool* threadPool)
+    : pool(threadPool),
+      rng(randomSeed()),
+      coinBits(0),
+      coinCount(0) {
+}
+
+void MazeGenerator::generate(const GeneratorConfig& config, MazeGrid& grid) {
+    // Loops get their own stream so they don't shift the carving sequence
+    Rng loopRng(config.seed != 0 ? mixSeed(config.seed ^ LOOP_STREAM) : rng.next());
+    
+    if (config.algorithm == GeneratorAlgorithm::ELLER) {
+        grid.assign(config.rows, config.cols, '#');
+        generateRows(config, [&grid](int row, const string& cells) {
+            for (int col = 0; col < static_cast<int>(cells.size()); col++) {
+                grid.at(row, col) = cells[col];
+            }
+        });
+    } else if (config.algorithm == GeneratorAlgorithm::TILED) {
+        carveTiled(config, grid);
+    } else {
+        carveBacktracker(config, grid);
+    }
+    
+    if (config.loopDensity > 0.f) {
+        addLoops(grid, config.loopDensity, loopRng);
+    }
+}
+
+int MazeGenerator::addLoops(MazeGrid& grid, float density, Rng& random) {
+    // Walls between two open rooms: left/right on a room row, above/below
+    // on a room column. Corner posts (even row and column) are left alone
+    // so no open 2x2 blocks appear. The border ring is wall, so every
+    // neighbour read stays inside the grid.
+    loopWalls.clear();
+    int across = grid.neighborOffset(2);
+    int along = grid.neighborOffset(0);
+    for (int row = 0; row < grid.getRows(); row++) {
+        int idx = grid.index(row, 0);
+        for (int col = 0; col < grid.getCols(); col++, idx++) {
+            if (grid[idx] == '#' &&
+                (((row & 1) && grid[idx - across] == '.' && grid[idx + across] == '.') ||
+                 ((col & 1) && grid[idx - along] == '.' && grid[idx + along] == '.'))) {
+                loopWalls.push_back(idx);
+            }
+        }
+    }
+    
+    // Partial Fisher-Yates: the first 'count' slots end up a uniform sample
+    double fraction = max(0.0, min(1.0, static_cast<double>(density)));
+    size_t count = min(loopWalls.size(), static_cast<size_t>(fraction * loopWalls.size() + 0.5));
+    for (size_t i = 0; i < count; i++) {
+        size_t pick = i + random.below(static_cast<uint32_t>(loopWalls.size() - i));
+        swap(loopWalls[i], loopWalls[pick]);
+        grid[loopWalls[i]] = '.';
+    }
+    return static_cast<int>(count);
+}
+
+void MazeGenerator::reseed(const GeneratorConfig& config) {
+    if (config.seed != 0) {
+        rng.seed(config.seed);
+        coinCount = 0;
+    }
+}
+
+void MazeGenerator::carveBacktracker(const GeneratorConfig& config, MazeGrid& grid) {
+    reseed(config);
+    
+    // Initialize maze with all walls
+    grid.assign(config.rows, config.cols, '#');
+    
+    // Rooms at rows/cols 1, 3, 5, ... strictly inside the outer ring
+    int roomRows = (config.rows - 1) / 2;
+    int roomCols = (config.cols - 1) / 2;
+    if (roomRows > 0 && roomCols > 0) {
+        carveRegion(grid, 0, 0, roomRows, roomCols, rng, buffers);
+    }
+}
+
+void MazeGenerator::carveTiled(const GeneratorConfig& config, MazeGrid& grid) {
+    uint64_t baseSeed = config.seed != 0 ? config.seed : rng.next();
+    grid.assign(config.rows, config.cols, '#');
+    
+    int roomRows = (config.rows - 1) / 2;
+    int roomCols = (config.cols - 1) / 2;
+    if (roomRows <= 0 || roomCols <= 0) {
+        return;
+    }
+    int tile = max(1, config.tileRooms);
+    int tileRows = (roomRows + tile - 1) / tile;
+    int tileCols = (roomCols + tile - 1) / tile;
+    int tileCount = tileRows * tileCols;
+    
+    // Tiles own disjoint cells (their rooms and the walls between them),
+    // so they can be carved concurrently into the same grid
+    auto carveTile = [&](int index, int slot) {
+        int firstRoomRow = (index / tileCols) * tile;
+        int firstRoomCol = (index % tileCols) * tile;
+        Rng tileRng(mixSeed(baseSeed ^ mixSeed(static_cast<uint64_t>(index) + 1)));
+        carveRegion(grid, firstRoomRow, firstRoomCol, min(tile, roomRows - firstRoomRow),
+                    min(tile, roomCols - firstRoomCol), tileRng, tileBuffers[slot]);
+    };
+    
+    if (!pool) {
+        pool = &ThreadPool::shared();
+    }
+    if (tileCount > 1 && pool->size() > 1) {
+        if (tileBuffers.size() < static_cast<size_t>(pool->size())) {
+            tileBuffers.resize(pool->size());
+        }
+        pool->parallelFor(tileCount, carveTile);
+    } else {
+        if (tileBuffers.empty()) {
+            tileBuffers.resize(1);
+        }
+        for (int index = 0; index < tileCount; index++) {
+            carveTile(index, 0);
+        }
+    }
+    
+    // Random spanning tree over the tiles (Kruskal on shuffled edges). An
+    // edge is tile * 2, to the tile on the right, or tile * 2 + 1, below.
+    Rng stitchRng(baseSeed);
+    vector<int> edges;
+    edges.reserve(2 * tileCount);
+    for (int index = 0; index < tileCount; index++) {
+        if (index % tileCols + 1 < tileCols) {
+            edges.push_back(index * 2);
+        }
+        if (index / tileCols + 1 < tileRows) {
+            edges.push_back(index * 2 + 1);
+        }
+    }
+    for (size_t i = edges.size(); i > 1; i--) {
+        swap(edges[i - 1], edges[stitchRng.below(static_cast<uint32_t>(i))]);
+    }
+    
+    parent.resize(tileCount);
+    for (int index = 0; index < tileCount; index++) {
+        parent[index] = index;
+    }
+    for (int edge : edges) {
+        int from = edge / 2;
+        bool below = edge & 1;
+        int to = below ? from + tileCols : from + 1;
+        int fromSet = findSet(from);
+        int toSet = findSet(to);
+        if (fromSet == toSet) {
+            continue;
+        }
+        parent[toSet] = fromSet;
+        
+        // Open one wall along the shared boundary. 'from' has a neighbour on
+        // that side, so it is a full tile in that direction.
+        int firstRoomRow = (from / tileCols) * tile;
+        int firstRoomCol = (from % tileCols) * tile;
+        if (below) {
+            int lastRow = firstRoomRow + tile - 1;
+            int col = firstRoomCol + static_cast<int>(stitchRng.below(min(tile, roomCols - firstRoomCol)));
+            grid.at(2 * lastRow + 2, 2 * col + 1) = '.';
+        } else {
+            int lastCol = firstRoomCol + tile - 1;
+            int row = firstRoomRow + static_cast<int>(stitchRng.below(min(tile, roomRows - firstRoomRow)));
+            grid.at(2 * row + 1, 2 * lastCol + 2) = '.';
+        }
+    }
+}
+
+void MazeGenerator::carveRegion(MazeGrid& grid, int firstRoomRow, int firstRoomCol, int regionRows,
+                                int regionCols, Rng& random, CarveBuffers& scratch) {
+    size_t roomCount = static_cast<size_t>(regionRows) * regionCols;
+    
+    // Every room is pushed at most once, so the stack never outgrows this
+    vector<uint64_t>& visited = scratch.visited;
+    vector<uint64_t>& directions = scratch.directions;
+    visited.assign((roomCount + 63) / 64, 0);
+    directions.resize((roomCount + 31) / 32);
+    size_t depth = 0;
+    
+    // Linear offsets of one step and of a whole room (two steps) per direction
+    int step[4], jump[4];
+    for (int i = 0; i < 4; i++) {
+        step[i] = grid.neighborOffset(i);
+        jump[i] = 2 * step[i];
+    }
+    int roomStep[4] = {-regionCols, regionCols, -1, 1};
+    
+    // Start from the top-left room
+    int roomRow = 0, roomCol = 0;
+    size_t room = 0;
+    int cell = grid.index(2 * firstRoomRow + 1, 2 * firstRoomCol + 1);
+    visited[0] |= 1;
+    grid[cell] = '.';
+    
+    // Recursive backtracking algorithm
+    while (true) {
+        // Collect unvisited neighbour rooms into a fixed array
+        int options[4];
+        int count = 0;
+        for (int i = 0; i < 4; i++) {
+            int nextRow = roomRow + dx[i];
+            int nextCol = roomCol + dy[i];
+            if (nextRow < 0 || nextRow >= regionRows || nextCol < 0 || nextCol >= regionCols) {
+                continue;
+            }
+            size_t next = room + roomStep[i];
+            if (!((visited[next >> 6] >> (next & 63)) & 1)) {
+                options[count++] = i;
+            }
+        }
+        
+        if (count > 0) {
+            // Carve through the wall into a random neighbour and descend
+            int dir = options[count == 1 ? 0 : random.below(count)];
+            grid[cell + step[dir]] = '.';
+            cell += jump[dir];
+            grid[cell] = '.';
+            
+            roomRow += dx[dir];
+            roomCol += dy[dir];
+            room += roomStep[dir];
+            visited[room >> 6] |= uint64_t(1) << (room & 63);
+            
+            uint64_t& word = directions[depth >> 5];
+            int shift = static_cast<int>(depth & 31) * 2;
+            word = (word & ~(uint64_t(3) << shift)) | (static_cast<uint64_t>(dir) << shift);
+            depth++;
+        } else {
+            // No unvisited neighbours: step back the way we came
+            if (depth == 0) {
+                break;
+            }
+            depth--;
+            int dir = static_cast<int>((directions[depth >> 5] >> ((depth & 31) * 2)) & 3);
+            cell -= jump[dir];
+            roomRow -= dx[dir];
+            roomCol -= dy[dir];
+            room -= roomStep[dir];
+        }
+    }
+}
+
+bool MazeGenerator::flipCoin() {
+    // One engine call serves 64 flips
+    if (coinCount == 0) {
+        coinBits = rng.next();
+        coinCount = 64;
+    }
+    coinCount--;
+    bool heads = coinBits & 1;
+    coinBits >>= 1;
+    return heads;
+}
+
+int MazeGenerator::findSet(int label) {
+    while (parent[label] != label) {
+        parent[label] = parent[parent[label]];   // Path halving
+        label = parent[label];
+    }
+    return label;
+}
+
+void MazeGenerator::generateRows(const GeneratorConfig& config, const RowCallback& emit) {
+    reseed(config);
+    int roomRows = max(0, (config.rows - 1) / 2);
+    int roomCols = max(0, (config.cols - 1) / 2);
+    line.assign(max(0, config.cols), '#');
+    
+    // Top wall, plus every row when there is no room to carve
+    emit(0, line);
+    if (roomRows == 0 || roomCols == 0) {
+        for (int row = 1; row < config.rows; row++) {
+            emit(row, line);
+        }
+        return;
+    }
+    
+    // Each room starts in its own set; labels stay within [0, roomCols)
+    setOf.resize(roomCols);
+    parent.resize(roomCols);
+    remaining.resize(roomCols);
+    down.resize(roomCols);
+    labelUsed.resize(roomCols);
+    for (int col = 0; col < roomCols; col++) {
+        setOf[col] = col;
+    }
+    
+    for (int roomRow = 0; roomRow < roomRows; roomRow++) {
+        bool lastRow = roomRow == roomRows - 1;
+        for (int col = 0; col < roomCols; col++) {
+            parent[setOf[col]] = setOf[col];
+        }
+        
+        // Join neighbours in different sets at random (all of them on the
+        // last row, which is what ties the maze into one tree)
+        line.assign(config.cols, '#');
+        line[1] = '.';
+        for (int col = 0; col + 1 < roomCols; col++) {
+            line[2 * col + 3] = '.';
+            int left = findSet(setOf[col]);
+            int right = findSet(setOf[col + 1]);
+            if (left != right && (lastRow || flipCoin())) {
+                parent[right] = left;
+                line[2 * col + 2] = '.';
+            }
+        }
+        for (int col = 0; col < roomCols; col++) {
+            setOf[col] = findSet(setOf[col]);
+        }
+        emit(2 * roomRow + 1, line);
+        
+        if (lastRow) {
+            break;
+        }
+        
+        // Open rooms downward at random, forcing the last room of a set that
+        // has no way down yet so no set is cut off
+        for (int col = 0; col < roomCols; col++) {
+            remaining[setOf[col]] = 0;
+            labelUsed[col] = 0;
+        }
+        for (int col = 0; col < roomCols; col++) {
+            remaining[setOf[col]]++;
+        }
+        line.assign(config.cols, '#');
+        for (int col = 0; col < roomCols; col++) {
+            int set = setOf[col];
+            remaining[set]--;
+            bool open = flipCoin() || (remaining[set] == 0 && !labelUsed[set]);
+            down[col] = open;
+            if (open) {
+                labelUsed[set] = 1;
+                line[2 * col + 1] = '.';
+            }
+        }
+        emit(2 * roomRow + 2, line);
+        
+        // Rooms below an opening keep their set; the rest get unused labels.
+        // Every kept set owns at least one opening, so there are enough.
+        int freeLabel = 0;
+        for (int col = 0; col < roomCols; col++) {
+            if (!down[col]) {
+                while (labelUsed[freeLabel]) {
+                    freeLabel++;
+                }
+                setOf[col] = freeLabel++;
+            }
+        }
+    }
+    
+    // Wall rows below the last room row
+    line.assign(config.cols, '#');
+    for (int row = 2 * roomRows; row < config.rows; row++) {
+        emit(row, line);
+    }
+}
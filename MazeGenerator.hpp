@@ -0,0 +1,117 @@
+/*
+ * MazeGenerator.hpp - Perfect maze generation for arbitrary dimensions
+ */
+
+#ifndef MAZEGENERATOR_HPP
+#define MAZEGENERATOR_HPP
+
+#include "MazeGrid.hpp"
+#include "Random.hpp"
+#include "ThreadPool.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Perfect maze algorithms MazeGenerator can run
+enum class GeneratorAlgorithm {
+    BACKTRACKER,   // Long winding corridors, needs the whole grid
+    ELLER,         // Row at a time in O(cols) memory, shorter dead ends
+    TILED          // Backtracker per tile on every core, tiles joined by a spanning tree
+};
+
+// Parameters of a generated maze
+struct GeneratorConfig {
+    int rows;    // Including the outer wall ring; rooms sit on odd rows/cols
+    int cols;
+    GeneratorAlgorithm algorithm;
+    uint64_t seed;   // Same seed, same maze; 0 keeps drawing from the generator's own stream
+    int tileRooms;   // TILED: tile edge in rooms (a tile spans 2 * tileRooms cells)
+    float loopDensity; // Fraction of the separating walls generate() knocks out (0 = perfect maze)
+    
+    GeneratorConfig(int r = 15, int c = 20, GeneratorAlgorithm a = GeneratorAlgorithm::BACKTRACKER,
+                    uint64_t s = 0)
+        : rows(r), cols(c), algorithm(a), seed(s), tileRooms(256), loopDensity(0.f) {}
+    
+    bool operator==(const GeneratorConfig& other) const {
+        return rows == other.rows && cols == other.cols && algorithm == other.algorithm &&
+               seed == other.seed && tileRooms == other.tileRooms && loopDensity == other.loopDensity;
+    }
+};
+
+// Receives one finished grid row ('#' and '.') of a streamed maze
+using RowCallback = function<void(int row, const string& line)>;
+
+// Recursive backtracker (iterative DFS) over the "rooms" at odd coordinates.
+// Bookkeeping stays near a bit per cell no matter the size: one visited bit
+// per room (a quarter of the cells) and a DFS stack that stores only the
+// 2-bit direction each room was entered from, since backtracking just steps
+// the opposite way. Both buffers are sized once per generate() and kept, so
+// regenerating at the same size allocates nothing beyond the grid itself.
+// GeneratorAlgorithm::ELLER routes generate() through generateRows().
+//
+// GeneratorAlgorithm::TILED cuts the rooms into square tiles and carves
+// each one as its own perfect maze on the thread pool, then opens exactly
+// one wall across the boundary of each edge of a random spanning tree over
+// the tiles, which keeps the whole grid a single tree. Every tile draws
+// from a stream derived from the seed and its index, so the result does
+// not depend on the thread count.
+class MazeGenerator {
+private:
+    // Backtracker bookkeeping, one set per concurrent carve
+    struct CarveBuffers {
+        vector<uint64_t> visited;      // One bit per room
+        vector<uint64_t> directions;   // DFS stack, 32 packed directions per word
+    };
+    CarveBuffers buffers;
+    vector<CarveBuffers> tileBuffers;  // One per pool slot
+    ThreadPool* pool;
+    
+    // Eller state, one entry per room column
+    vector<int> setOf;             // Set label of each room in the current row
+    vector<int> parent;            // Union-find over labels, reset every row
+    vector<int> remaining;         // Rooms of a set not yet given a way down
+    vector<char> down;             // Room opens into the row below
+    vector<char> labelUsed;
+    string line;
+    vector<int> loopWalls;         // Candidate walls of the last addLoops()
+    Rng rng;
+    uint64_t coinBits;             // Unused random bits for coin flips
+    int coinCount;
+    
+    void reseed(const GeneratorConfig& config);
+    void carveBacktracker(const GeneratorConfig& config, MazeGrid& grid);
+    void carveTiled(const GeneratorConfig& config, MazeGrid& grid);
+    
+    // Carve a perfect maze over the rooms [firstRoomRow, +regionRows) x
+    // [firstRoomCol, +regionCols), touching no cell outside that block
+    static void carveRegion(MazeGrid& grid, int firstRoomRow, int firstRoomCol, int regionRows,
+                            int regionCols, Rng& random, CarveBuffers& scratch);
+    int findSet(int label);
+    bool flipCoin();
+    
+public:
+    // nullptr = ThreadPool::shared(), looked up on the first tiled run
+    explicit MazeGenerator(ThreadPool* threadPool = nullptr);
+    
+    // Fill 'grid' with a perfect maze of config.rows x config.cols: every
+    // room reachable from (1, 1) by exactly one path, everything else wall.
+    // A non-zero config.loopDensity then braids it with addLoops().
+    void generate(const GeneratorConfig& config, MazeGrid& grid);
+    
+    // Open round(density * n) of the n walls that sit between two open
+    // rooms, chosen uniformly. One scan collects the candidates and a
+    // partial shuffle picks from them, so the cost is O(cells) however
+    // sparse the candidates are. Returns the number of walls opened.
+    int addLoops(MazeGrid& grid, float density, Rng& random);
+    
+    // Eller's algorithm: emits the same kind of maze as generate() one grid
+    // row at a time, top to bottom, holding only O(config.cols) state. The
+    // line passed to 'emit' is reused for the next row. Always perfect:
+    // loopDensity is not applied.
+    void generateRows(const GeneratorConfig& config, const RowCallback& emit);
+};
+
+#endif // MAZEGENERATOR_HPP
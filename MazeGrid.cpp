@@ -0,0 +1,33 @@
+/*
+ * MazeGrid.cpp - Flat row-major maze storage implementation
+ */
+
+#include "MazeGrid.hpp"
+#include "Common.hpp"
+#include <algorithm>
+
+using namespace std;
+
+MazeGrid::MazeGrid()
+    : rows(0),
+      cols(0),
+      stride(2),
+      offsets{0, 0, 0, 0} {
+}
+
+void MazeGrid::assign(int mazeRows, int mazeCols, char fill) {
+    rows = max(0, mazeRows);
+    cols = max(0, mazeCols);
+    stride = cols + 2;
+    
+    // One allocation for the whole grid; the border is part of the buffer
+    cells.assign(static_cast<size_t>(rows + 2) * stride, SENTINEL);
+    for (int r = 0; r < rows; r++) {
+        char* row = cells.data() + index(r, 0);
+        fill_n(row, cols, fill);
+    }
+    
+    for (int i = 0; i < 4; i++) {
+        offsets[i] = dx[i] * stride + dy[i];
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ * MazeGrid.hpp - Flat row-major maze storage
+ */
+
+#ifndef MAZEGRID_HPP
+#define MAZEGRID_HPP
+
+#include "Common.hpp"
+#include <vector>
+
+using namespace std;
+
+// Lightweight read-only view of a MazeGrid. view[row][col] indexes the same
+// way the old vector<vector<char>> did, without copying the grid.
+class MazeGridView {
+private:
+    const char* origin;  // Address of cell (0, 0)
+    int rows, cols;
+    int stride;          // Distance in bytes between two rows
+    
+public:
+    MazeGridView(const char* o, int r, int c, int s)
+        : origin(o), rows(r), cols(c), stride(s) {}
+    
+    const char* operator[](int row) const { return origin + row * stride; }
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+};
+
+// Contiguous grid with a one-cell wall border around the playable area.
+// Cells are addressed either by (row, col) or by a linear index; a neighbour
+// of any playable cell is always inside the buffer, so solvers can step with
+// index + neighborOffset(dir) and never need a bounds check.
+class MazeGrid {
+private:
+    vector<char> cells;    // (rows + 2) x (cols + 2) cells, border included
+    int rows, cols;        // Playable dimensions
+    int stride;            // cols + 2
+    int offsets[4];        // Linear offsets matching dx/dy
+    
+public:
+    static constexpr char SENTINEL = '#';
+    
+    MazeGrid();
+    
+    // Resize to mazeRows x mazeCols, fill with 'fill' and rebuild the border
+    void assign(int mazeRows, int mazeCols, char fill);
+    
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int getStride() const { return stride; }
+    int getCellCount() const { return static_cast<int>(cells.size()); }  // Including border
+    
+    // Coordinate <-> linear index conversion
+    int index(int row, int col) const { return (row + 1) * stride + col + 1; }
+    int rowOf(int idx) const { return idx / stride - 1; }
+    int colOf(int idx) const { return idx % stride - 1; }
+    int neighborOffset(int dir) const { return offsets[dir]; }
+    
+    bool inBounds(int row, int col) const {
+        return row >= 0 && row < rows && col >= 0 && col < cols;
+    }
+    
+    char at(int row, int col) const { return cells[index(row, col)]; }
+    char& at(int row, int col) { return cells[index(row, col)]; }
+    char operator[](int idx) const { return cells[idx]; }
+    char& operator[](int idx) { return cells[idx]; }
+    
+    // Anything that is not a wall can be walked on ('.', '~', 'G', ...)
+    bool isOpen(int idx) const { return cells[idx] != '#'; }
+    
+    // Cost of stepping onto an open cell (see cellCost)
+    int cost(int idx) const { return cellCost(cells[idx]); }
+    
+    MazeGridView view() const { return MazeGridView(cells.data() + stride + 1, rows, cols, stride); }
+};
+
+#endif // MAZEGRID_HPP
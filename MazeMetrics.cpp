@@ -0,0 +1,112 @@
+/*
+ * MazeMetrics.cpp - Maze measurement implementation
+ */
+
+#include "MazeMetrics.hpp"
+#include <algorithm>
+
+using namespace std;
+
+void MazeMetricsAnalyzer::measure(const MazeGrid& grid, int startRow, int startCol, int goalRow, int goalCol,
+                                  MazeMetrics& metrics) {
+    metrics = MazeMetrics();
+    int cellCount = grid.getCellCount();
+    int offsets[4];
+    for (int i = 0; i < 4; i++) {
+        offsets[i] = grid.neighborOffset(i);
+    }
+    
+    // Neighbour counts; the wall border keeps every read in range
+    neighbours.assign(cellCount, 0);
+    long long degreeSum = 0;
+    long long junctionExits = 0;
+    for (int row = 0; row < grid.getRows(); row++) {
+        int idx = grid.index(row, 0);
+        for (int col = 0; col < grid.getCols(); col++, idx++) {
+            if (!grid.isOpen(idx)) {
+                continue;
+            }
+            int count = 0;
+            for (int i = 0; i < 4; i++) {
+                count += grid.isOpen(idx + offsets[i]);
+            }
+            neighbours[idx] = static_cast<uint8_t>(count);
+            metrics.openCells++;
+            degreeSum += count;
+            if (count == 1) {
+                metrics.deadEnds++;
+            } else if (count >= 3) {
+                metrics.junctions++;
+                junctionExits += count - 1;
+            }
+        }
+    }
+    if (metrics.junctions > 0) {
+        metrics.branchingFactor = static_cast<float>(junctionExits) / metrics.junctions;
+    }
+    
+    // Components by flood fill, then the cyclomatic number
+    seen.assign(cellCount, 0);
+    for (int row = 0; row < grid.getRows(); row++) {
+        int idx = grid.index(row, 0);
+        for (int col = 0; col < grid.getCols(); col++, idx++) {
+            if (!grid.isOpen(idx) || seen[idx]) {
+                continue;
+            }
+            metrics.components++;
+            seen[idx] = 1;
+            stack.assign(1, idx);
+            while (!stack.empty()) {
+                int current = stack.back();
+                stack.pop_back();
+                for (int i = 0; i < 4; i++) {
+                    int next = current + offsets[i];
+                    if (grid.isOpen(next) && !seen[next]) {
+                        seen[next] = 1;
+                        stack.push_back(next);
+                    }
+                }
+            }
+        }
+    }
+    long long edges = degreeSum / 2;
+    metrics.loops = static_cast<int>(edges - metrics.openCells + metrics.components);
+    
+    // Corridors: grow each unvisited two-neighbour cell both ways until the
+    // run ends at a junction or dead end (or closes on itself)
+    fill(seen.begin(), seen.end(), 0);
+    long long corridorCells = 0;
+    for (int idx = 0; idx < cellCount; idx++) {
+        if (neighbours[idx] != 2 || seen[idx]) {
+            continue;
+        }
+        int length = 0;
+        seen[idx] = 1;
+        stack.assign(1, idx);
+        while (!stack.empty()) {
+            int current = stack.back();
+            stack.pop_back();
+            length++;
+            for (int i = 0; i < 4; i++) {
+                int next = current + offsets[i];
+                if (neighbours[next] == 2 && !seen[next]) {
+                    seen[next] = 1;
+                    stack.push_back(next);
+                }
+            }
+        }
+        if (static_cast<int>(metrics.corridorLengths.size()) <= length) {
+            metrics.corridorLengths.resize(length + 1, 0);
+        }
+        metrics.corridorLengths[length]++;
+        metrics.corridorCount++;
+        corridorCells += length;
+    }
+    if (metrics.corridorCount > 0) {
+        metrics.meanCorridorLength = static_cast<float>(corridorCells) / metrics.corridorCount;
+    }
+    
+    // Only the length matters, so layers are expanded a word at a time
+    bitboard.build(grid);
+    metrics.solutionLength = bitboard.distance(startRow, startCol, goalRow, goalCol).value_or(-1);
+}
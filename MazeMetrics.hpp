@@ -0,0 +1,54 @@
+/*
+ * MazeMetrics.hpp - Structural measurements of a maze for difficulty tuning
+ */
+
+#ifndef MAZEMETRICS_HPP
+#define MAZEMETRICS_HPP
+
+#include "MazeGrid.hpp"
+#include "BitboardBFS.hpp"
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Everything is counted over open cells, as a graph where each open cell
+// links to its open neighbours
+struct MazeMetrics {
+    int openCells;
+    int solutionLength;        // BFS steps from start to goal, -1 if unreachable
+    int deadEnds;              // Open cells with exactly one open neighbour
+    int junctions;             // Open cells with three or four open neighbours
+    float branchingFactor;     // Mean ways onward at a junction (neighbours - 1), 0 without junctions
+    int loops;                 // Independent cycles: edges - cells + components
+    int components;            // Separate connected regions
+    
+    // Corridors are maximal runs of cells with exactly two open neighbours.
+    // corridorLengths[n] counts corridors of n cells (index 0 unused).
+    vector<int> corridorLengths;
+    int corridorCount;
+    float meanCorridorLength;
+    
+    MazeMetrics()
+        : openCells(0), solutionLength(-1), deadEnds(0), junctions(0), branchingFactor(0.f),
+          loops(0), components(0), corridorCount(0), meanCorridorLength(0.f) {}
+};
+
+// Computes MazeMetrics in O(cells): one pass for neighbour counts, one
+// flood per component and one walk per corridor, plus a bit-parallel BFS
+// for the solution length (no path is needed). Scratch buffers are kept,
+// so a worker measuring a batch of mazes allocates only when the size
+// grows. Not thread-safe; use one per thread.
+class MazeMetricsAnalyzer {
+private:
+    vector<uint8_t> neighbours;   // Open neighbour count per cell (linear index)
+    vector<char> seen;
+    vector<int> stack;
+    BitboardBFS bitboard;
+    
+public:
+    void measure(const MazeGrid& grid, int startRow, int startCol, int goalRow, int goalCol,
+                 MazeMetrics& metrics);
+};
+
+#endif // MAZEMETRICS_HPP
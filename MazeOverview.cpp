@@ -0,0 +1,163 @@
+/*
+ * MazeOverview.cpp - One-texel-per-cell maze texture implementation
+ */
+
+#include "MazeOverview.hpp"
+#include <algorithm>
+
+using namespace std;
+using namespace sf;
+
+namespace {
+    const unsigned BYTES_PER_PIXEL = 4;
+    
+    Color texelColor(char cell) {
+        if (keyType(cell) >= 0) {
+            return GameColors::KeyColor;
+        } else if (cell == '*') {
+            return GameColors::CheckpointColor;
+        }
+        return cellColor(cell);
+    }
+}
+
+MazeOverview::MazeOverview()
+    : rows(0),
+      cols(0),
+      step(1),
+      originRow(0),
+      originCol(0),
+      revision(0),
+      appliedChanges(0),
+      built(false),
+      textureReady(false) {
+}
+
+void MazeOverview::update(const Maze& maze) {
+    if (!built || revision != maze.getLevelRevision() || rows != maze.getRows() || cols != maze.getCols()) {
+        rebuild(maze);
+        return;
+    }
+    
+    // Wrap around a slide of the endless window; blocks of cells can't
+    // shift by a single cell, so those grids start over
+    int64_t slideRow = maze.getWindowRow() - originRow;
+    int64_t slideCol = maze.getWindowCol() - originCol;
+    if (slideRow != 0 || slideCol != 0) {
+        if (!textureReady || step != 1 || slideRow <= -rows || slideRow >= rows || slideCol <= -cols ||
+            slideCol >= cols) {
+            rebuild(maze);
+            return;
+        }
+        slideWindow(maze, static_cast<int>(slideRow), static_cast<int>(slideCol));
+    }
+    
+    // Rewrite and upload only the texels of cells edited since the last update
+    const vector<Cell>& changes = maze.getCellChanges();
+    if (appliedChanges == changes.size()) {
+        return;
+    }
+    if (textureReady) {
+        MazeGridView grid = maze.getMazeData();
+        unsigned width = image.getSize().x;
+        for (size_t i = appliedChanges; i < changes.size(); i++) {
+            const Cell& changed = changes[i];
+            bool onGrid = changed.row >= 0 && changed.row < rows && changed.col >= 0 && changed.col < cols;
+            if (!onGrid || changed.row % step != 0 || changed.col % step != 0) {
+                continue;
+            }
+            Vector2u texel = texelOf(changed.row, changed.col);
+            image.setPixel(texel, texelColor(grid[changed.row][changed.col]));
+            texture.update(image.getPixelsPtr() + (static_cast<size_t>(texel.y) * width + texel.x) * BYTES_PER_PIXEL,
+                           Vector2u(1, 1), texel);
+        }
+    }
+    appliedChanges = changes.size();
+}
+
+void MazeOverview::slideWindow(const Maze& maze, int slideRow, int slideCol) {
+    originRow += slideRow;
+    originCol += slideCol;
+    ring.x = ((ring.x + slideCol) % cols + cols) % cols;
+    ring.y = ((ring.y + slideRow) % rows + rows) % rows;
+    MazeGridView grid = maze.getMazeData();
+    
+    // Rows that scrolled in, each a whole texel row
+    int firstRow = slideRow > 0 ? rows - slideRow : 0;
+    int endRow = slideRow > 0 ? rows : -slideRow;
+    for (int row = firstRow; row < endRow; row++) {
+        unsigned y = texelOf(row, 0).y;
+        for (int col = 0; col < cols; col++) {
+            image.setPixel(texelOf(row, col), texelColor(grid[row][col]));
+        }
+        texture.update(image.getPixelsPtr() + static_cast<size_t>(y) * cols * BYTES_PER_PIXEL,
+                       Vector2u(static_cast<unsigned>(cols), 1), Vector2u(0, y));
+    }
+    
+    // Columns that scrolled in; an image column is not contiguous, so each
+    // is gathered in texel order first
+    int firstCol = slideCol > 0 ? cols - slideCol : 0;
+    int endCol = slideCol > 0 ? cols : -slideCol;
+    columnPixels.resize(static_cast<size_t>(rows) * BYTES_PER_PIXEL);
+    for (int col = firstCol; col < endCol; col++) {
+        unsigned x = texelOf(0, col).x;
+        for (int row = 0; row < rows; row++) {
+            Vector2u texel = texelOf(row, col);
+            Color color = texelColor(grid[row][col]);
+            image.setPixel(texel, color);
+            uint8_t* pixel = &columnPixels[static_cast<size_t>(texel.y) * BYTES_PER_PIXEL];
+            pixel[0] = color.r;
+            pixel[1] = color.g;
+            pixel[2] = color.b;
+            pixel[3] = color.a;
+        }
+        texture.update(columnPixels.data(), Vector2u(1, static_cast<unsigned>(rows)), Vector2u(x, 0));
+    }
+}
+
+Vector2u MazeOverview::texelOf(int row, int col) const {
+    Vector2u size = image.getSize();
+    return Vector2u((static_cast<unsigned>(col / step) + ring.x) % size.x,
+                    (static_cast<unsigned>(row / step) + ring.y) % size.y);
+}
+
+void MazeOverview::rebuild(const Maze& maze) {
+    rows = maze.getRows();
+    cols = maze.getCols();
+    originRow = maze.getWindowRow();
+    originCol = maze.getWindowCol();
+    ring = Vector2i(0, 0);
+    revision = maze.getLevelRevision();
+    appliedChanges = maze.getCellChanges().size();
+    built = true;
+    
+    // One texel per cell, or per block of cells if the grid won't fit a texture
+    int maxSize = static_cast<int>(Texture::getMaximumSize());
+    step = max(1, max((rows + maxSize - 1) / maxSize, (cols + maxSize - 1) / maxSize));
+    Vector2u size(static_cast<unsigned>((cols + step - 1) / step), static_cast<unsigned>((rows + step - 1) / step));
+    textureReady = size.x > 0 && size.y > 0 && texture.resize(size);
+    if (!textureReady) {
+        return;
+    }
+    
+    texture.setRepeated(true);
+    image.resize(size, GameColors::PathColor);
+    MazeGridView grid = maze.getMazeData();
+    for (unsigned y = 0; y < size.y; y++) {
+        const char* mazeRow = grid[static_cast<int>(y) * step];
+        for (unsigned x = 0; x < size.x; x++) {
+            image.setPixel(Vector2u(x, y), texelColor(mazeRow[static_cast<int>(x) * step]));
+        }
+    }
+    texture.update(image);
+}
+
+void MazeOverview::draw(RenderTarget& target, Vector2f position, float cellSize) const {
+    if (!textureReady) {
+        return;
+    }
+    Sprite sprite(texture, IntRect(ring, Vector2i(image.getSize())));
+    sprite.setPosition(position);
+    sprite.setScale(Vector2f(cellSize * step, cellSize * step));
+    target.draw(sprite);
+}
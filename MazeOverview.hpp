@@ -0,0 +1,61 @@
+/*
+ * MazeOverview.hpp - One-texel-per-cell maze texture
+ */
+
+#ifndef MAZEOVERVIEW_HPP
+#define MAZEOVERVIEW_HPP
+
+#include "Maze.hpp"
+#include "Common.hpp"
+#include <SFML/Graphics.hpp>
+
+using namespace std;
+using namespace sf;
+
+// The whole grid as an image with one pixel per cell, mirrored in a
+// texture, for views where cells are too small to be worth their own
+// quads: the far-zoom map and the minimap. Keys and checkpoints colour
+// their texel instead of getting a marker.
+//
+// Like MazeRenderer, update() follows the maze's level revision and cell
+// change log. A new level fills the image and uploads it once; after that
+// each changed cell rewrites its pixel and uploads just that texel, so a
+// picked-up key costs four bytes however large the maze is. Grids larger
+// than the GPU's texture limit keep one texel per 'step' x 'step' block,
+// sampled from the block's top-left cell.
+//
+// The texture repeats and is read from 'ring' onwards, wrapping at its
+// edges, so a slide of the endless window only moves 'ring' and uploads
+// the rows and columns that scrolled in.
+class MazeOverview {
+private:
+    Image image;
+    Texture texture;
+    int rows, cols;
+    int step;                 // Cells per texel along each axis
+    int64_t originRow, originCol; // Maze window origin the texels refer to
+    Vector2i ring;            // Texel holding grid cell (0, 0), as (x, y)
+    vector<uint8_t> columnPixels; // One texel column, gathered for upload
+    unsigned revision;        // Maze level revision the image was built from
+    size_t appliedChanges;    // Entries of the maze's change log already applied
+    bool built;
+    bool textureReady;        // Texture sized and filled for the current grid
+    
+    void rebuild(const Maze& maze);
+    void slideWindow(const Maze& maze, int slideRow, int slideCol);
+    Vector2u texelOf(int row, int col) const;
+    
+public:
+    MazeOverview();
+    
+    // Bring the image, and the texture, up to date with 'maze'
+    void update(const Maze& maze);
+    
+    // The maze with its top-left corner at 'position' and each cell
+    // 'cellSize' pixels across
+    void draw(RenderTarget& target, Vector2f position, float cellSize) const;
+    
+    bool isReady() const { return textureReady; }
+};
+
+#endif // MAZEOVERVIEW_HPP
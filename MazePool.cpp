@@ -0,0 +1,177 @@
+/*
+ * MazePool.cpp - Background level pre-generation implementation
+ */
+
+#include "MazePool.hpp"
+#include "Maze.hpp"
+#include <algorithm>
+#include <new>
+
+using namespace std;
+
+namespace {
+    // Configurations kept stocked at once (e.g. a few window sizes)
+    const size_t MAX_SHELVES = 4;
+    
+    // Cells a shelf's ready levels may add up to before its depth drops
+    const int64_t SHELF_CELL_BUDGET = 1 << 26;
+}
+
+MazePool::MazePool(int readyPerConfig)
+    : depth(max(1, readyPerConfig)),
+      stopping(false),
+      worker(&MazePool::workerLoop, this) {
+}
+
+MazePool::~MazePool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    workNeeded.notify_all();
+    worker.join();
+}
+
+MazePool::Shelf* MazePool::findShelf(const GeneratorConfig& config, const DifficultyTarget& target) {
+    for (Shelf& shelf : shelves) {
+        if (shelf.config == config && shelf.target == target) {
+            return &shelf;
+        }
+    }
+    return nullptr;
+}
+
+void MazePool::stock(const GeneratorConfig& config, const DifficultyTarget& target) {
+    if (config.seed != 0) {
+        return;
+    }
+    {
+        lock_guard<mutex> guard(lock);
+        if (Shelf* existing = findShelf(config, target)) {
+            if (existing->wanted) {
+                return;
+            }
+            existing->wanted = true;
+        } else {
+            if (shelves.size() >= MAX_SHELVES) {
+                // Drop the oldest configuration; its levels become spares
+                for (unique_ptr<Maze>& level : shelves.front().ready) {
+                    spares.push_back(move(level));
+                }
+                shelves.erase(shelves.begin());
+            }
+            Shelf shelf;
+            shelf.config = config;
+            shelf.target = target;
+            int64_t cells = max<int64_t>(1, static_cast<int64_t>(config.rows) * config.cols);
+            shelf.depth = static_cast<int>(max<int64_t>(1, min<int64_t>(depth, SHELF_CELL_BUDGET / cells)));
+            shelf.onDemand = cells > SHELF_CELL_BUDGET;
+            shelf.wanted = true;
+            shelf.failed = false;
+            shelves.push_back(move(shelf));
+        }
+    }
+    workNeeded.notify_one();
+}
+
+unique_ptr<Maze> MazePool::take(const GeneratorConfig& config, const DifficultyTarget& target) {
+    unique_ptr<Maze> level;
+    {
+        lock_guard<mutex> guard(lock);
+        Shelf* shelf = findShelf(config, target);
+        if (!shelf || shelf->ready.empty()) {
+            return nullptr;
+        }
+        level = move(shelf->ready.back());
+        shelf->ready.pop_back();
+        
+        // Building the next one now would hold two huge levels at once
+        if (shelf->onDemand) {
+            shelf->wanted = false;
+        }
+    }
+    workNeeded.notify_one();
+    return level;
+}
+
+void MazePool::recycle(unique_ptr<Maze> level) {
+    if (!level) {
+        return;
+    }
+    lock_guard<mutex> guard(lock);
+    spares.push_back(move(level));
+}
+
+int MazePool::readyCount(const GeneratorConfig& config, const DifficultyTarget& target) {
+    lock_guard<mutex> guard(lock);
+    Shelf* shelf = findShelf(config, target);
+    return shelf ? static_cast<int>(shelf->ready.size()) : 0;
+}
+
+bool MazePool::hasFailed(const GeneratorConfig& config, const DifficultyTarget& target) {
+    lock_guard<mutex> guard(lock);
+    Shelf* shelf = findShelf(config, target);
+    return shelf && shelf->failed;
+}
+
+void MazePool::workerLoop() {
+    while (true) {
+        GeneratorConfig config;
+        DifficultyTarget difficulty;
+        unique_ptr<Maze> level;
+        {
+            // Sleep until some shelf is short of levels
+            unique_lock<mutex> guard(lock);
+            Shelf* target = nullptr;
+            workNeeded.wait(guard, [&] {
+                if (stopping) {
+                    return true;
+                }
+                // Newest configuration first: it is the one about to be played
+                for (auto shelf = shelves.rbegin(); shelf != shelves.rend(); ++shelf) {
+                    if (shelf->wanted && !shelf->failed && static_cast<int>(shelf->ready.size()) < shelf->depth) {
+                        target = &*shelf;
+                        return true;
+                    }
+                }
+                return false;
+            });
+            if (stopping) {
+                return;
+            }
+            config = target->config;
+            difficulty = target->target;
+            if (!spares.empty()) {
+                level = move(spares.back());
+                spares.pop_back();
+            }
+        }
+        
+        // Build outside the lock; the UI thread only ever waits on the swap
+        if (!level) {
+            level = make_unique<Maze>();
+        }
+        bool built = true;
+        try {
+            level->setGeneratorConfig(config);
+            level->setDifficultyTarget(difficulty);
+            level->loadLevel(3);
+        } catch (const bad_alloc&) {
+            // Free the partial level before anything else needs memory
+            level.reset();
+            built = false;
+        }
+        
+        lock_guard<mutex> guard(lock);
+        Shelf* shelf = findShelf(config, difficulty);
+        if (!built) {
+            if (shelf) {
+                shelf->failed = true;
+            }
+        } else if (shelf && static_cast<int>(shelf->ready.size()) < shelf->depth) {
+            shelf->ready.push_back(move(level));
+        } else {
+            spares.push_back(move(level));
+        }
+    }
+}
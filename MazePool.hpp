@@ -0,0 +1,84 @@
+/*
+ * MazePool.hpp - Background pre-generation of ready-to-play levels
+ */
+
+#ifndef MAZEPOOL_HPP
+#define MAZEPOOL_HPP
+
+#include "MazeGenerator.hpp"
+#include "DifficultySearch.hpp"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+class Maze;
+
+// Keeps a few generated levels per configuration (generator settings and
+// difficulty target) built ahead of time on a worker thread, so loading
+// one on the UI thread is a buffer swap instead of a generate + solve.
+// Each pooled level is a whole Maze that ran loadLevel(3) in the
+// background: grid, distance fields, key heuristics and waypoints are all
+// done. Maze::loadLevel takes one, swaps its level state in and hands the
+// emptied Maze back through recycle(), so its buffers are reused for the
+// next build and nothing large is freed on the UI thread.
+//
+// Only unseeded configurations are pooled; a seeded level is always the
+// same maze and is built in place. A Level 3 holds about 18 bytes per cell
+// plus its tour's cost fields (at most RouteOptimizer::FIELD_BUDGET cells),
+// so large configurations keep fewer levels ready, down to one, and one
+// too large to keep a second copy of is rebuilt only when stocked again.
+// A build that runs out of memory marks its configuration failed instead
+// of taking the process down.
+class MazePool {
+private:
+    struct Shelf {
+        GeneratorConfig config;
+        DifficultyTarget target;
+        int depth;                     // Levels kept ready, fewer for large levels
+        bool onDemand;                 // Refilled only when stocked again after a take
+        bool wanted;                   // Worker should keep this shelf filled
+        bool failed;                   // A build ran out of memory; not retried
+        vector<unique_ptr<Maze>> ready;
+    };
+    
+    vector<Shelf> shelves;             // Most recently stocked last
+    vector<unique_ptr<Maze>> spares;   // Emptied levels waiting to be rebuilt
+    int depth;                         // Levels kept ready per configuration
+    
+    mutex lock;
+    condition_variable workNeeded;
+    bool stopping;
+    thread worker;
+    
+    void workerLoop();
+    Shelf* findShelf(const GeneratorConfig& config, const DifficultyTarget& target);
+    
+public:
+    explicit MazePool(int readyPerConfig = 2);
+    ~MazePool();
+    
+    MazePool(const MazePool&) = delete;
+    MazePool& operator=(const MazePool&) = delete;
+    
+    // Keep levels of 'config' searched to 'target' ready from now on. Only
+    // the last few configurations stay stocked; older shelves are dropped.
+    void stock(const GeneratorConfig& config, const DifficultyTarget& target);
+    
+    // A finished level for 'config' and 'target', or nullptr if none is ready yet
+    unique_ptr<Maze> take(const GeneratorConfig& config, const DifficultyTarget& target);
+    
+    // Return a Maze whose level was swapped out, for reuse
+    void recycle(unique_ptr<Maze> level);
+    
+    // Levels ready for 'config' and 'target' right now
+    int readyCount(const GeneratorConfig& config, const DifficultyTarget& target);
+    
+    // True once a build for 'config' and 'target' ran out of memory
+    bool hasFailed(const GeneratorConfig& config, const DifficultyTarget& target);
+};
+
+#endif // MAZEPOOL_HPP
@@ -0,0 +1,224 @@
+/*
+ * MazeRenderer.cpp - Batched maze grid geometry implementation
+ */
+
+#include "MazeRenderer.hpp"
+#include <cmath>
+
+using namespace std;
+using namespace sf;
+
+namespace {
+    const int VERTICES_PER_CELL = 6;
+    const int ROUND_SIDES = 24;   // Sides of the polygons standing in for circles
+    const float PI = 3.14159265f;
+    
+    bool hasMarker(char cell) {
+        return keyType(cell) >= 0 || cell == '*';
+    }
+}
+
+MazeRenderer::MazeRenderer()
+    : cells(PrimitiveType::Triangles),
+      markers(PrimitiveType::Triangles),
+      rows(0),
+      cols(0),
+      originRow(0),
+      originCol(0),
+      revision(0),
+      appliedChanges(0),
+      built(false),
+      layerReady(false) {
+}
+
+void MazeRenderer::update(const Maze& maze, const IntRect& visible) {
+    // Cells the window slid by since the build; the geometry still shows
+    // the same world cells, just drawn that many cells back
+    int64_t slideRow = maze.getWindowRow() - originRow;
+    int64_t slideCol = maze.getWindowCol() - originCol;
+    bool slidOff = slideRow <= -rows || slideRow >= rows || slideCol <= -cols || slideCol >= cols;
+    if (built && !slidOff) {
+        slide = Vector2i(static_cast<int>(slideCol), static_cast<int>(slideRow));
+    }
+    if (!built || slidOff || revision != maze.getLevelRevision() || rows != maze.getRows() ||
+        cols != maze.getCols() || !covers(visible)) {
+        rebuild(maze, visible);
+        return;
+    }
+    
+    // Only cells edited since the last update need new colours; cells
+    // outside the region are read fresh when it moves over them
+    const vector<Cell>& changes = maze.getCellChanges();
+    if (appliedChanges == changes.size()) {
+        return;
+    }
+    MazeGridView grid = maze.getMazeData();
+    for (size_t i = appliedChanges; i < changes.size(); i++) {
+        const Cell& changed = changes[i];
+        Vector2i held(changed.col + slide.x, changed.row + slide.y);
+        if (changed.row >= 0 && changed.row < rows && changed.col >= 0 && changed.col < cols &&
+            region.contains(held)) {
+            setCellColor(held.y, held.x, grid[changed.row][changed.col]);
+        }
+    }
+    appliedChanges = changes.size();
+    rebuildMarkers(maze);
+    drawLayer();
+}
+
+bool MazeRenderer::covers(const IntRect& visible) const {
+    // Visible cells clamped to the grid must all be in the region, which
+    // is held in the coordinates from before any slide
+    int firstCol = max(visible.position.x, 0) + slide.x;
+    int firstRow = max(visible.position.y, 0) + slide.y;
+    int endCol = min(visible.position.x + visible.size.x, cols) + slide.x;
+    int endRow = min(visible.position.y + visible.size.y, rows) + slide.y;
+    return firstCol >= region.position.x && firstRow >= region.position.y &&
+           endCol <= region.position.x + region.size.x && endRow <= region.position.y + region.size.y;
+}
+
+void MazeRenderer::rebuild(const Maze& maze, const IntRect& visible) {
+    rows = maze.getRows();
+    cols = maze.getCols();
+    originRow = maze.getWindowRow();
+    originCol = maze.getWindowCol();
+    slide = Vector2i(0, 0);
+    revision = maze.getLevelRevision();
+    appliedChanges = maze.getCellChanges().size();
+    built = true;
+    
+    // The visible cells plus half their extent on each side, within the grid
+    int marginCols = visible.size.x / 2 + 1;
+    int marginRows = visible.size.y / 2 + 1;
+    int firstCol = max(0, visible.position.x - marginCols);
+    int firstRow = max(0, visible.position.y - marginRows);
+    int endCol = min(cols, visible.position.x + visible.size.x + marginCols);
+    int endRow = min(rows, visible.position.y + visible.size.y + marginRows);
+    region = IntRect(Vector2i(firstCol, firstRow), Vector2i(max(0, endCol - firstCol), max(0, endRow - firstRow)));
+    
+    // Two triangles per cell, inset a pixel so the background shows between cells
+    cells.resize(static_cast<size_t>(region.size.x) * region.size.y * VERTICES_PER_CELL);
+    markerCells.clear();
+    MazeGridView grid = maze.getMazeData();
+    for (int row = firstRow; row < endRow; row++) {
+        const char* mazeRow = grid[row];
+        for (int col = firstCol; col < endCol; col++) {
+            Vertex* quad = &cells[(static_cast<size_t>(row - firstRow) * region.size.x + col - firstCol) *
+                                  VERTICES_PER_CELL];
+            float left = static_cast<float>(WINDOW_PADDING + col * CELL_SIZE + 1);
+            float top = static_cast<float>(WINDOW_PADDING + row * CELL_SIZE + 1);
+            float right = left + CELL_SIZE - 2;
+            float bottom = top + CELL_SIZE - 2;
+            quad[0].position = Vector2f(left, top);
+            quad[1].position = Vector2f(right, top);
+            quad[2].position = Vector2f(left, bottom);
+            quad[3].position = Vector2f(left, bottom);
+            quad[4].position = Vector2f(right, top);
+            quad[5].position = Vector2f(right, bottom);
+            setCellColor(row, col, mazeRow[col]);
+            
+            if (hasMarker(mazeRow[col])) {
+                markerCells.push_back(Cell(row, col, 0));
+            }
+        }
+    }
+    rebuildMarkers(maze);
+    resizeLayer();
+    drawLayer();
+}
+
+void MazeRenderer::resizeLayer() {
+    Vector2u size(static_cast<unsigned>(region.size.x * CELL_SIZE), static_cast<unsigned>(region.size.y * CELL_SIZE));
+    if (!layerReady || size.x != layerSize.x || size.y != layerSize.y) {
+        unsigned maxSize = Texture::getMaximumSize();
+        layerSize = size;
+        layerReady = size.x > 0 && size.y > 0 && size.x <= maxSize && size.y <= maxSize && layer.resize(size);
+    }
+    if (layerReady) {
+        // Geometry stays in world coordinates; the view maps the region onto the texture
+        layer.setView(View(FloatRect(regionOrigin(), Vector2f(static_cast<float>(size.x), static_cast<float>(size.y)))));
+    }
+}
+
+Vector2f MazeRenderer::regionOrigin() const {
+    return Vector2f(static_cast<float>(WINDOW_PADDING + region.position.x * CELL_SIZE),
+                    static_cast<float>(WINDOW_PADDING + region.position.y * CELL_SIZE));
+}
+
+Vector2f MazeRenderer::slideOffset() const {
+    return Vector2f(static_cast<float>(-slide.x * CELL_SIZE), static_cast<float>(-slide.y * CELL_SIZE));
+}
+
+void MazeRenderer::drawLayer() {
+    if (!layerReady) {
+        return;
+    }
+    // Transparent, so the background still shows between cells
+    layer.clear(Color::Transparent);
+    layer.draw(cells);
+    if (markers.getVertexCount() > 0) {
+        layer.draw(markers);
+    }
+    layer.display();
+}
+
+void MazeRenderer::setCellColor(int row, int col, char cell) {
+    Color color = cellColor(cell);
+    Vertex* quad = &cells[(static_cast<size_t>(row - region.position.y) * region.size.x + col - region.position.x) *
+                          VERTICES_PER_CELL];
+    for (int i = 0; i < VERTICES_PER_CELL; i++) {
+        quad[i].color = color;
+    }
+}
+
+void MazeRenderer::rebuildMarkers(const Maze& maze) {
+    // Markers only ever disappear within a level, so the cells found at the
+    // last full rebuild are the only candidates
+    markers.clear();
+    MazeGridView grid = maze.getMazeData();
+    for (const Cell& marked : markerCells) {
+        int row = marked.row - slide.y;
+        int col = marked.col - slide.x;
+        if (row < 0 || row >= rows || col < 0 || col >= cols) {
+            continue;   // Slid off the grid; not on screen either
+        }
+        char cell = grid[row][col];
+        float left = static_cast<float>(WINDOW_PADDING + marked.col * CELL_SIZE);
+        float top = static_cast<float>(WINDOW_PADDING + marked.row * CELL_SIZE);
+        Vector2f center(left + CELL_SIZE / 2.f, top + CELL_SIZE / 2.f);
+        
+        if (keyType(cell) >= 0) {
+            // Key - gold coin
+            addPolygon(center, CELL_SIZE / 4.f, ROUND_SIDES, 0.f, GameColors::KeyColor);
+        } else if (cell == '*') {
+            // Checkpoint - diamond
+            addPolygon(center, CELL_SIZE / 4.f, 4, -PI / 2, GameColors::CheckpointColor);
+        }
+    }
+}
+
+void MazeRenderer::addPolygon(Vector2f center, float radius, int sides, float rotation, Color color) {
+    // A fan of triangles from the centre, flattened into the triangle list
+    for (int i = 0; i < sides; i++) {
+        float from = rotation + 2 * PI * i / sides;
+        float to = rotation + 2 * PI * (i + 1) / sides;
+        markers.append(Vertex{center, color, Vector2f()});
+        markers.append(Vertex{center + Vector2f(cos(from), sin(from)) * radius, color, Vector2f()});
+        markers.append(Vertex{center + Vector2f(cos(to), sin(to)) * radius, color, Vector2f()});
+    }
+}
+
+void MazeRenderer::draw(RenderTarget& target) const {
+    if (layerReady) {
+        Sprite sprite(layer.getTexture());
+        sprite.setPosition(regionOrigin() + slideOffset());
+        target.draw(sprite);
+        return;
+    }
+    RenderStates states;
+    states.transform.translate(slideOffset());
+    target.draw(cells, states);
+    if (markers.getVertexCount() > 0) {
+        target.draw(markers, states);
+    }
+}
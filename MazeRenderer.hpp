@@ -0,0 +1,72 @@
+/*
+ * MazeRenderer.hpp - Batched maze grid geometry
+ */
+
+#ifndef MAZERENDERER_HPP
+#define MAZERENDERER_HPP
+
+#include "Maze.hpp"
+#include "Common.hpp"
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+using namespace std;
+using namespace sf;
+
+// Keeps a region of the grid in one vertex array, two triangles per cell
+// in row-major order, with key coins and checkpoint diamonds on top in a
+// second, much smaller array. The region is the visible cells plus half a
+// screen of margin on every side, so scrolling rebuilds it only once the
+// view leaves it, and the cost follows the screen area rather than the
+// maze size. update() also follows the maze's level revision and cell
+// change log: a new level rebuilds the region, a picked-up key or
+// checkpoint recolours one cell and rebuilds only the markers. A slide of
+// the endless window keeps the geometry in the coordinates it was built
+// in and only offsets where it is drawn, until the view leaves the region.
+//
+// Both arrays are then rasterized once into a render texture covering the
+// region, so a frame that changes nothing draws the grid as a single
+// textured quad. Regions larger than the GPU's texture limit skip the layer
+// and draw the arrays directly. The player and goal glow are not part of
+// the layer; the screen draws them over it every frame.
+class MazeRenderer {
+private:
+    VertexArray cells;        // 6 vertices per cell
+    VertexArray markers;      // Triangles for the decorations of markerCells
+    vector<Cell> markerCells; // Cells drawn with a decoration at the last rebuild
+    int rows, cols;
+    IntRect region;           // Cells held: position = (col, row), size = (cols, rows)
+    int64_t originRow, originCol; // Maze window origin the region's coordinates refer to
+    Vector2i slide;           // Window movement since then, in cells (col, row)
+    unsigned revision;        // Maze level revision the geometry was built from
+    size_t appliedChanges;    // Entries of the maze's change log already applied
+    bool built;
+    
+    RenderTexture layer;      // Grid area, cells and markers already drawn
+    Vector2u layerSize;
+    bool layerReady;          // Layer sized for the current region
+    
+    void rebuild(const Maze& maze, const IntRect& visible);
+    bool covers(const IntRect& visible) const;
+    void setCellColor(int row, int col, char cell);
+    void rebuildMarkers(const Maze& maze);
+    void addPolygon(Vector2f center, float radius, int sides, float rotation, Color color);
+    void resizeLayer();
+    Vector2f regionOrigin() const;
+    Vector2f slideOffset() const;
+    void drawLayer();
+    
+public:
+    MazeRenderer();
+    
+    // Bring the geometry, and the layer, up to date with 'maze' for the
+    // cells in 'visible' (clamped to the grid)
+    void update(const Maze& maze, const IntRect& visible);
+    
+    // The cached layer (one draw call), or the two arrays without one
+    void draw(RenderTarget& target) const;
+    
+    size_t getVertexCount() const { return cells.getVertexCount() + markers.getVertexCount(); }
+};
+
+#endif // MAZERENDERER_HPP
@@ -9,9 +9,27 @@
 using namespace std;
 using namespace sf;
 
+namespace {
+    const int CURSOR_BLINK_MS = 500;   // Cursor shown and hidden for this long each
+}
+
 NameScreen::NameScreen(RenderWindow* win, Font* f, string& name)
-    : ScreenBase(win, f), playerName(name), namePromptText(*f, "Enter Your Name (Max 15 Chars):", 28) {
-    namePromptText.setFillColor(Color::White);
+    : ScreenBase(win, f),
+      playerName(name),
+      gameTitle(*f, "ALGOMAZE", 56, Color(50, 200, 100), Text::Style::Bold),
+      subtitle(*f, "Welcome, Player", 24, Color(200, 200, 220)),
+      namePromptText(*f, "Enter Your Name (Max 15 Chars):", 28, Color(180, 200, 255)),
+      nameText(*f, "", 32, Color(220, 255, 220), Text::Style::Bold),
+      countText(*f, "0 / 15", 16, Color(150, 150, 170)),
+      instructionText(*f, "Press ENTER to continue", 20, Color(150, 180, 200), Text::Style::Italic),
+      hintText(*f, "Tip: Use letters, numbers, and spaces only", 16, Color(100, 120, 140)) {
+    gameTitle.setAnchor(Vector2f(0.5f, 0.5f));
+    subtitle.setAnchor(Vector2f(0.5f, 0.5f));
+    namePromptText.setAnchor(Vector2f(0.5f, 0.5f));
+    nameText.setAnchor(Vector2f(0.f, 0.5f));
+    countText.setAnchor(Vector2f(1.f, 0.5f));
+    instructionText.setAnchor(Vector2f(0.5f, 0.5f));
+    hintText.setAnchor(Vector2f(0.5f, 0.5f));
 }
 
 void NameScreen::draw() {
@@ -38,37 +56,16 @@ void NameScreen::draw() {
     }
     
     // Draw game title/logo text
-    Text gameTitle(*font, "ALGOMAZE", 56);
-    gameTitle.setFillColor(Color(50, 200, 100));
-    gameTitle.setStyle(Text::Style::Bold);
-    FloatRect titleBounds = gameTitle.getLocalBounds();
-    gameTitle.setOrigin(Vector2f(
-        titleBounds.position.x + titleBounds.size.x / 2.f,
-        titleBounds.position.y + titleBounds.size.y / 2.f
-    ));
     gameTitle.setPosition(Vector2f(size.x / 2.f, size.y / 2.f - 200.f));
-    window->draw(gameTitle);
+    gameTitle.draw(*window);
     
     // Draw subtitle
-    Text subtitle(*font, "Welcome, Player", 24);
-    subtitle.setFillColor(Color(200, 200, 220));
-    FloatRect subtitleBounds = subtitle.getLocalBounds();
-    subtitle.setOrigin(Vector2f(
-        subtitleBounds.position.x + subtitleBounds.size.x / 2.f,
-        subtitleBounds.position.y + subtitleBounds.size.y / 2.f
-    ));
     subtitle.setPosition(Vector2f(size.x / 2.f, size.y / 2.f - 140.f));
-    window->draw(subtitle);
+    subtitle.draw(*window);
     
     // Draw name prompt text
-    FloatRect promptBounds = namePromptText.getLocalBounds();
-    namePromptText.setOrigin(Vector2f(
-        promptBounds.position.x + promptBounds.size.x / 2.f,
-        promptBounds.position.y + promptBounds.size.y / 2.f
-    ));
     namePromptText.setPosition(Vector2f(size.x / 2.f, size.y / 2.f - 80.f));
-    namePromptText.setFillColor(Color(180, 200, 255));
-    window->draw(namePromptText);
+    namePromptText.draw(*window);
     
     // Draw professional input box
     float boxWidth = 450.f;
@@ -98,26 +95,23 @@ void NameScreen::draw() {
     innerGlow.setPosition(Vector2f(boxX + 2.f, boxY + 2.f));
     window->draw(innerGlow);
     
-    // Draw player name text inside the box
-    string displayName = playerName;
-    Text nameText(*font, displayName, 32);
-    nameText.setFillColor(Color(220, 255, 220));
-    nameText.setStyle(Text::Style::Bold);
-    FloatRect nameBounds = nameText.getLocalBounds();
-    nameText.setOrigin(Vector2f(
-        nameBounds.position.x,
-        nameBounds.position.y + nameBounds.size.y / 2.f
-    ));
+    // Draw player name text inside the box; the name and its length are
+    // only laid out again after an edit
+    if (nameText.getString() != playerName) {
+        nameText.setString(playerName);
+        countText.setString(to_string(playerName.length()) + " / 15");
+    }
     nameText.setPosition(Vector2f(boxX + 20.f, boxY + boxHeight / 2.f));
-    window->draw(nameText);
+    nameText.draw(*window);
+    FloatRect nameBounds = nameText.getBounds();
     
     // Animated blinking cursor
-    float cursorBlinkTime = cursorBlinkClock.getElapsedTime().asSeconds();
-    bool showCursor = (static_cast<int>(cursorBlinkTime * 2) % 2) == 0;
+    int cursorBlinkTime = cursorBlinkClock.getElapsedTime().asMilliseconds();
+    bool showCursor = (cursorBlinkTime / CURSOR_BLINK_MS) % 2 == 0;
     
     if (showCursor) {
         float cursorX = boxX + 20.f + nameBounds.size.x;
-        if (displayName.empty()) {
+        if (playerName.empty()) {
             cursorX = boxX + 20.f;
         }
         
@@ -128,39 +122,16 @@ void NameScreen::draw() {
     }
     
     // Character count indicator
-    string charCount = to_string(playerName.length()) + " / 15";
-    Text countText(*font, charCount, 16);
-    countText.setFillColor(Color(150, 150, 170));
-    FloatRect countBounds = countText.getLocalBounds();
-    countText.setOrigin(Vector2f(
-        countBounds.position.x + countBounds.size.x,
-        countBounds.position.y + countBounds.size.y / 2.f
-    ));
     countText.setPosition(Vector2f(boxX + boxWidth - 15.f, boxY + boxHeight / 2.f));
-    window->draw(countText);
+    countText.draw(*window);
     
     // Draw instruction text
-    Text instructionText(*font, "Press ENTER to continue", 20);
-    instructionText.setFillColor(Color(150, 180, 200));
-    instructionText.setStyle(Text::Style::Italic);
-    FloatRect instructionBounds = instructionText.getLocalBounds();
-    instructionText.setOrigin(Vector2f(
-        instructionBounds.position.x + instructionBounds.size.x / 2.f,
-        instructionBounds.position.y + instructionBounds.size.y / 2.f
-    ));
     instructionText.setPosition(Vector2f(size.x / 2.f, size.y / 2.f + 100.f));
-    window->draw(instructionText);
+    instructionText.draw(*window);
     
     // Draw hint text
-    Text hintText(*font, "Tip: Use letters, numbers, and spaces only", 16);
-    hintText.setFillColor(Color(100, 120, 140));
-    FloatRect hintBounds = hintText.getLocalBounds();
-    hintText.setOrigin(Vector2f(
-        hintBounds.position.x + hintBounds.size.x / 2.f,
-        hintBounds.position.y + hintBounds.size.y / 2.f
-    ));
     hintText.setPosition(Vector2f(size.x / 2.f, size.y / 2.f + 130.f));
-    window->draw(hintText);
+    hintText.draw(*window);
     
     // Draw decorative bottom border
     RectangleShape bottomBorder(Vector2f(static_cast<float>(size.x), 4.f));
@@ -205,3 +176,8 @@ optional<GameState> NameScreen::handleInput(const Event& event) {
     return nullopt;
 }
 
+int NameScreen::getRedrawDelayMs() const {
+    // Next time the cursor toggles
+    int cursorBlinkTime = cursorBlinkClock.getElapsedTime().asMilliseconds();
+    return CURSOR_BLINK_MS - cursorBlinkTime % CURSOR_BLINK_MS;
+}
@@ -7,6 +7,7 @@
 
 #include "ScreenBase.hpp"
 #include "GameState.hpp"
+#include "Label.hpp"
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <optional>
@@ -18,12 +19,21 @@ class NameScreen : public ScreenBase {
 private:
     string& playerName;  // Reference to player name (owned by GameEngine)
     Clock cursorBlinkClock;
-    Text namePromptText;
+    
+    // Built once; the name and count change only when the name is edited
+    Label gameTitle;
+    Label subtitle;
+    Label namePromptText;
+    Label nameText;
+    Label countText;
+    Label instructionText;
+    Label hintText;
     
 public:
     NameScreen(RenderWindow* win, Font* f, string& name);
     void draw() override;
     optional<GameState> handleInput(const Event& event) override;
+    int getRedrawDelayMs() const override;
 };
 
 #endif // NAMESCREEN_HPP
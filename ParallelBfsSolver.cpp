@@ -0,0 +1,224 @@
+/*
+ * ParallelBfsSolver.cpp - Multi-threaded level-synchronous BFS implementation
+ */
+
+#include "ParallelBfsSolver.hpp"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+    const uint64_t NO_KEY = UINT64_MAX;
+    
+    // Layers smaller than this are cheaper to expand on one thread
+    const size_t PARALLEL_MIN_CELLS = 4096;
+    
+    // Cells (or bit words) per chunk handed to a worker
+    const size_t CHUNK_CELLS = 2048;
+    
+    // Go bottom-up once the frontier is at least 1/ALPHA of the unsettled
+    // open cells (Beamer et al. use 14 for general graphs)
+    const size_t BOTTOM_UP_ALPHA = 14;
+    
+    inline void atomicMin(atomic<uint64_t>& slot, uint64_t value) {
+        uint64_t current = slot.load(memory_order_relaxed);
+        while (value < current && !slot.compare_exchange_weak(current, value, memory_order_relaxed)) {
+        }
+    }
+    
+    inline bool isSettled(const atomic<uint64_t>* bits, int idx) {
+        return (bits[idx >> 6].load(memory_order_relaxed) >> (idx & 63)) & 1;
+    }
+}
+
+ParallelBfsSolver::ParallelBfsSolver(ThreadPool* threadPool)
+    : pool(threadPool ? threadPool : &ThreadPool::shared()),
+      capacity(0),
+      bottomUpLayers(0) {
+}
+
+void ParallelBfsSolver::reserve(size_t cellCount) {
+    if (cellCount > capacity) {
+        parentKey.reset(new atomic<uint64_t>[cellCount]);
+        settled.reset(new atomic<uint64_t>[(cellCount + 63) / 64]);
+        order.resize(cellCount);
+        position.resize(cellCount);
+        capacity = cellCount;
+    }
+}
+
+void ParallelBfsSolver::runChunks(int chunks, bool parallel, const function<void(int chunk)>& body) {
+    if (!parallel || chunks <= 1 || pool->size() <= 1) {
+        for (int chunk = 0; chunk < chunks; chunk++) {
+            body(chunk);
+        }
+        return;
+    }
+    pool->parallelFor(chunks, [&](int chunk, int) { body(chunk); });
+}
+
+bool ParallelBfsSolver::search(const MazeGrid& grid, int start, int goal, SolverWorkspace& workspace,
+                               vector<Cell>& path, SolveStats& stats) {
+    (void)workspace;
+    bottomUpLayers = 0;
+    
+    size_t cellCount = static_cast<size_t>(grid.getCellCount());
+    size_t wordCount = (cellCount + 63) / 64;
+    reserve(cellCount);
+    bool large = cellCount >= PARALLEL_MIN_CELLS;
+    
+    int offsets[4];
+    for (int i = 0; i < 4; i++) {
+        offsets[i] = grid.neighborOffset(i);
+    }
+    
+    // Reset keys and bits, and count open cells for the direction heuristic.
+    // Bits past the last cell start set so bottom-up never visits them.
+    int resetChunks = static_cast<int>((wordCount + CHUNK_CELLS - 1) / CHUNK_CELLS);
+    vector<size_t> openPerChunk(resetChunks, 0);
+    runChunks(resetChunks, large, [&](int chunk) {
+        size_t wordBegin = chunk * CHUNK_CELLS;
+        size_t wordEnd = min(wordCount, wordBegin + CHUNK_CELLS);
+        size_t cellEnd = min(cellCount, wordEnd * 64);
+        for (size_t w = wordBegin; w < wordEnd; w++) {
+            settled[w].store(0, memory_order_relaxed);
+        }
+        for (size_t idx = wordBegin * 64; idx < cellEnd; idx++) {
+            parentKey[idx].store(NO_KEY, memory_order_relaxed);
+            openPerChunk[chunk] += grid.isOpen(static_cast<int>(idx));
+        }
+    });
+    if (cellCount % 64 != 0) {
+        settled[wordCount - 1].store(~uint64_t(0) << (cellCount % 64), memory_order_relaxed);
+    }
+    size_t openCount = 0;
+    for (size_t count : openPerChunk) {
+        openCount += count;
+    }
+    
+    order[0] = start;
+    position[start] = 0;
+    settled[start >> 6].fetch_or(uint64_t(1) << (start & 63), memory_order_relaxed);
+    
+    size_t layerBegin = 0, layerEnd = 1;
+    bool found = start == goal;
+    
+    while (!found && layerBegin < layerEnd) {
+        size_t frontier = layerEnd - layerBegin;
+        size_t unsettled = openCount - layerEnd;
+        bool parallel = large && (frontier >= PARALLEL_MIN_CELLS || unsettled >= PARALLEL_MIN_CELLS);
+        stats.nodesExpanded += static_cast<long long>(frontier);
+        
+        // Pass 1: discover the next layer
+        if (frontier * BOTTOM_UP_ALPHA >= unsettled) {
+            bottomUpLayers++;
+            int chunks = static_cast<int>((wordCount + CHUNK_CELLS - 1) / CHUNK_CELLS);
+            runChunks(chunks, parallel, [&](int chunk) {
+                size_t wordBegin = chunk * CHUNK_CELLS;
+                size_t wordEnd = min(wordCount, wordBegin + CHUNK_CELLS);
+                for (size_t w = wordBegin; w < wordEnd; w++) {
+                    uint64_t unsettledBits = ~settled[w].load(memory_order_relaxed);
+                    if (unsettledBits == 0) {
+                        continue;  // Whole word already settled
+                    }
+                    for (int bit = 0; bit < 64; bit++) {
+                        int cell = static_cast<int>(w * 64) + bit;
+                        if (!((unsettledBits >> bit) & 1) || !grid.isOpen(cell)) {
+                            continue;
+                        }
+                        // Only this chunk writes this cell, so a plain min will do
+                        uint64_t best = NO_KEY;
+                        for (int i = 0; i < 4; i++) {
+                            int from = cell - offsets[i];
+                            if (isSettled(settled.get(), from) && position[from] >= layerBegin) {
+                                best = min(best, uint64_t(position[from]) * 4 + static_cast<uint64_t>(i));
+                            }
+                        }
+                        if (best != NO_KEY) {
+                            parentKey[cell].store(best, memory_order_relaxed);
+                        }
+                    }
+                }
+            });
+        } else {
+            int chunks = static_cast<int>((frontier + CHUNK_CELLS - 1) / CHUNK_CELLS);
+            runChunks(chunks, parallel, [&](int chunk) {
+                size_t begin = layerBegin + chunk * CHUNK_CELLS;
+                size_t end = min(layerEnd, begin + CHUNK_CELLS);
+                for (size_t p = begin; p < end; p++) {
+                    int current = order[p];
+                    for (int i = 0; i < 4; i++) {
+                        int next = current + offsets[i];
+                        if (grid.isOpen(next) && !isSettled(settled.get(), next)) {
+                            atomicMin(parentKey[next], uint64_t(p) * 4 + i);
+                        }
+                    }
+                }
+            });
+        }
+        
+        // Pass 2: collect the next layer in serial queue order
+        int chunks = static_cast<int>((frontier + CHUNK_CELLS - 1) / CHUNK_CELLS);
+        if (chunkCells.size() < static_cast<size_t>(chunks)) {
+            chunkCells.resize(chunks);
+        }
+        runChunks(chunks, parallel, [&](int chunk) {
+            vector<int>& cells = chunkCells[chunk];
+            cells.clear();
+            size_t begin = layerBegin + chunk * CHUNK_CELLS;
+            size_t end = min(layerEnd, begin + CHUNK_CELLS);
+            for (size_t p = begin; p < end; p++) {
+                int current = order[p];
+                for (int i = 0; i < 4; i++) {
+                    int next = current + offsets[i];
+                    if (parentKey[next].load(memory_order_relaxed) == uint64_t(p) * 4 + i) {
+                        cells.push_back(next);
+                    }
+                }
+            }
+        });
+        
+        // Append the chunk lists; each chunk copies its own slice
+        vector<size_t> slice(chunks + 1, layerEnd);
+        for (int chunk = 0; chunk < chunks; chunk++) {
+            slice[chunk + 1] = slice[chunk] + chunkCells[chunk].size();
+        }
+        atomic<bool> reachedGoal(false);
+        runChunks(chunks, parallel, [&](int chunk) {
+            size_t p = slice[chunk];
+            for (int cell : chunkCells[chunk]) {
+                order[p] = cell;
+                position[cell] = static_cast<uint32_t>(p);
+                settled[cell >> 6].fetch_or(uint64_t(1) << (cell & 63), memory_order_relaxed);
+                if (cell == goal) {
+                    reachedGoal.store(true, memory_order_relaxed);
+                }
+                p++;
+            }
+        });
+        
+        layerBegin = layerEnd;
+        layerEnd = slice[chunks];
+        found = reachedGoal.load();
+    }
+    
+    if (!found) {
+        return false;
+    }
+    
+    // Parent of a cell is the queue entry named by its key
+    int length = 0;
+    for (int idx = goal; idx != start; idx = order[parentKey[idx].load(memory_order_relaxed) >> 2]) {
+        length++;
+    }
+    path.resize(length + 1);
+    int idx = goal;
+    for (int step = length; step >= 0; step--) {
+        path[step] = Cell(grid.rowOf(idx), grid.colOf(idx), step);
+        if (step > 0) {
+            idx = order[parentKey[idx].load(memory_order_relaxed) >> 2];
+        }
+    }
+    
+    return true;
+}
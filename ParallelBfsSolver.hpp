@@ -0,0 +1,63 @@
+/*
+ * ParallelBfsSolver.hpp - Multi-threaded level-synchronous BFS strategy
+ */
+
+#ifndef PARALLELBFSSOLVER_HPP
+#define PARALLELBFSSOLVER_HPP
+
+#include "PathSolver.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Expands the BFS one whole layer at a time, splitting the layer across the
+// pool's threads. Each layer runs in two passes:
+//  1. Discover: every cell reachable from the layer records the smallest
+//     (queue position * 4 + direction) of the cells that reach it, with an
+//     atomic compare-and-swap min. Top-down walks the frontier; bottom-up
+//     walks the unsettled cells (found through atomic settled bits, 64 per
+//     word) and looks for a frontier neighbour. The cheaper direction is
+//     picked per layer from the frontier and unsettled sizes.
+//  2. Order: each chunk of the frontier re-walks its cells in queue order
+//     and keeps the neighbours whose recorded key names it, into a local
+//     list; the lists are appended in chunk order.
+// That smallest key is exactly the cell that would have dequeued first in
+// the serial BFS, so queue order, parents and the returned path are
+// identical to BfsSolver's for any thread count.
+//
+// Worth it from a few million cells up; small layers run on the calling
+// thread. Keeps its own buffers rather than the shared SolverWorkspace,
+// which has no atomic storage.
+class ParallelBfsSolver : public PathSolver {
+private:
+    ThreadPool* pool;
+    size_t capacity;
+    unique_ptr<atomic<uint64_t>[]> parentKey;   // Smallest position * 4 + direction that reached a cell;
+                                                // 64-bit so the key can't wrap past 2^30 cells
+    unique_ptr<atomic<uint64_t>[]> settled;     // One bit per cell, set once it is in 'order'
+    vector<int> order;                          // Cells in serial BFS queue order
+    vector<uint32_t> position;                  // Cell -> index in 'order', valid once settled
+    vector<vector<int>> chunkCells;             // Order pass output, one list per chunk
+    int bottomUpLayers;
+    
+    void reserve(size_t cellCount);
+    void runChunks(int chunks, bool parallel, const function<void(int chunk)>& body);
+    
+protected:
+    bool search(const MazeGrid& grid, int start, int goal, SolverWorkspace& workspace,
+                vector<Cell>& path, SolveStats& stats) override;
+    
+public:
+    // nullptr = ThreadPool::shared()
+    explicit ParallelBfsSolver(ThreadPool* threadPool = nullptr);
+    
+    const char* getName() const override { return "Parallel BFS"; }
+    
+    // Layers of the last search that ran bottom-up
+    int getBottomUpLayers() const { return bottomUpLayers; }
+};
+
+#endif // PARALLELBFSSOLVER_HPP
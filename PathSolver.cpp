@@ -0,0 +1,86 @@
+/*
+ * PathSolver.cpp - Pathfinding strategy interface implementation
+ */
+
+#include "PathSolver.hpp"
+#include "BfsSolver.hpp"
+#include "AStarSolver.hpp"
+#include "JpsSolver.hpp"
+#include "DijkstraSolver.hpp"
+#include "BidirectionalSolver.hpp"
+#include "ParallelBfsSolver.hpp"
+
+using namespace std;
+using namespace sf;
+
+bool PathSolver::solve(const MazeGrid& grid, int startRow, int startCol, int goalRow, int goalCol,
+                       SolverWorkspace& workspace, vector<Cell>& path, SolveStats& stats) {
+    path.clear();
+    stats = SolveStats();
+    
+    if (!grid.inBounds(startRow, startCol) || !grid.inBounds(goalRow, goalCol)) {
+        return false;
+    }
+    int start = grid.index(startRow, startCol);
+    int goal = grid.index(goalRow, goalCol);
+    if (!grid.isOpen(start) || !grid.isOpen(goal)) {
+        return false;
+    }
+    
+    Clock timer;
+    bool found = search(grid, start, goal, workspace, path, stats);
+    stats.milliseconds = timer.getElapsedTime().asMicroseconds() / 1000.f;
+    return found;
+}
+
+void PathSolver::tracePath(const MazeGrid& grid, const SolverWorkspace& workspace, int start, int goal,
+                           vector<Cell>& path) {
+    // Count the steps first so the path can be filled back to front
+    int length = 0;
+    for (int idx = goal; idx != start; idx = workspace.getParent(idx)) {
+        length++;
+    }
+    
+    path.resize(length + 1);
+    int idx = goal;
+    for (int step = length; step >= 0; step--) {
+        path[step] = Cell(grid.rowOf(idx), grid.colOf(idx), step);
+        idx = workspace.getParent(idx);
+    }
+}
+
+unique_ptr<PathSolver> createSolver(SolverType type) {
+    switch (type) {
+        case SolverType::ASTAR:
+            return make_unique<AStarSolver>();
+        case SolverType::JPS:
+            return make_unique<JpsSolver>();
+        case SolverType::DIJKSTRA:
+            return make_unique<DijkstraSolver>();
+        case SolverType::BIDIRECTIONAL:
+            return make_unique<BidirectionalSolver>();
+        case SolverType::PARALLEL_BFS:
+            return make_unique<ParallelBfsSolver>();
+        case SolverType::BFS:
+        default:
+            return make_unique<BfsSolver>();
+    }
+}
+
+SolverType selectFastestSolver(const MazeGrid& grid, int startRow, int startCol, int goalRow, int goalCol,
+                               SolverWorkspace& workspace) {
+    SolverType fastest = SolverType::BFS;
+    float bestTime = -1.f;
+    vector<Cell> path;
+    SolveStats stats;
+    
+    for (SolverType type : STEP_SOLVER_TYPES) {
+        unique_ptr<PathSolver> solver = createSolver(type);
+        solver->solve(grid, startRow, startCol, goalRow, goalCol, workspace, path, stats);
+        if (bestTime < 0.f || stats.milliseconds < bestTime) {
+            bestTime = stats.milliseconds;
+            fastest = type;
+        }
+    }
+    return fastest;
+}
@@ -0,0 +1,70 @@
+/*
+ * PathSolver.hpp - Pathfinding strategy interface
+ */
+
+#ifndef PATHSOLVER_HPP
+#define PATHSOLVER_HPP
+
+#include "Common.hpp"
+#include "MazeGrid.hpp"
+#include "SolverWorkspace.hpp"
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+// Available pathfinding strategies
+enum class SolverType {
+    BFS,            // Breadth-first search, cell by cell
+    ASTAR,          // A* with the Manhattan heuristic
+    JPS,            // Jump Point Search (4-connected) on top of A*
+    DIJKSTRA,       // Cheapest path by terrain cost, bucket queue
+    BIDIRECTIONAL,  // BFS from both ends, meeting in the middle
+    PARALLEL_BFS    // Level-synchronous BFS across the thread pool, same path as BFS
+};
+
+// Strategies that minimise the number of steps and so return paths of equal length
+const SolverType STEP_SOLVER_TYPES[] = {
+    SolverType::BFS, SolverType::ASTAR, SolverType::JPS, SolverType::BIDIRECTIONAL
+};
+
+// Per-solve measurements, filled by PathSolver::solve
+struct SolveStats {
+    long long nodesExpanded;   // Nodes taken off the queue / open list
+    float milliseconds;        // Wall time of the solve
+    
+    SolveStats() : nodesExpanded(0), milliseconds(0.f) {}
+};
+
+class PathSolver {
+protected:
+    // Strategy body. start and goal are linear indices of open cells; on
+    // success 'path' must hold every cell from start to goal.
+    virtual bool search(const MazeGrid& grid, int start, int goal, SolverWorkspace& workspace,
+                        vector<Cell>& path, SolveStats& stats) = 0;
+    
+    // Rebuild a cell-by-cell path from the workspace parent links
+    static void tracePath(const MazeGrid& grid, const SolverWorkspace& workspace, int start, int goal,
+                          vector<Cell>& path);
+    
+public:
+    virtual ~PathSolver() = default;
+    virtual const char* getName() const = 0;
+    
+    // Shortest path between two cells, start and goal inclusive, with
+    // Cell::distance set to the step index. The step solvers all return a
+    // path of the same length (ties may be broken differently); DIJKSTRA
+    // minimises the summed cellCost of every cell entered instead.
+    bool solve(const MazeGrid& grid, int startRow, int startCol, int goalRow, int goalCol,
+               SolverWorkspace& workspace, vector<Cell>& path, SolveStats& stats);
+};
+
+unique_ptr<PathSolver> createSolver(SolverType type);
+
+// Time every step solver once from start to goal on 'grid' and return the
+// fastest. Which one wins depends on the maze's shape: goal-directed search
+// in open rooms, plain BFS in tight corridors.
+SolverType selectFastestSolver(const MazeGrid& grid, int startRow, int startCol, int goalRow, int goalCol,
+                               SolverWorkspace& workspace);
+
+#endif // PATHSOLVER_HPP
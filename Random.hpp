@@ -0,0 +1,96 @@
+/*
+ * Random.hpp - Small, fast, reproducible pseudo-random number generator
+ */
+
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <cstdint>
+#include <random>
+
+using namespace std;
+
+// splitmix64's finalizer: scrambles a 64-bit value so that nearby inputs
+// (seed + 1, tile indices, ...) give unrelated outputs
+inline uint64_t mixSeed(uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+// xoshiro256** (Blackman & Vigna): 32 bytes of state and a handful of
+// shifts per number, against mt19937's 2.5 KB. Seeding runs the seed
+// through splitmix64, so any 64-bit value (including small ones) gives a
+// well-mixed state.
+//
+// The bounded helpers are defined here rather than taken from
+// <random>'s distributions, whose output differs between standard
+// libraries: a given seed yields the same sequence, and so the same maze,
+// on every platform.
+class Rng {
+private:
+    uint64_t state[4];
+    
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+    
+public:
+    using result_type = uint64_t;
+    
+    explicit Rng(uint64_t seedValue = 0) { seed(seedValue); }
+    
+    void seed(uint64_t seedValue) {
+        for (uint64_t& word : state) {
+            // splitmix64
+            seedValue += 0x9E3779B97F4A7C15ULL;
+            word = mixSeed(seedValue);
+        }
+    }
+    
+    uint64_t next() {
+        uint64_t result = rotl(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+    
+    // Uniform in [0, bound), bound > 0. Lemire's multiply-shift with
+    // rejection: unbiased, and almost never divides.
+    uint32_t below(uint32_t bound) {
+        uint64_t product = (next() >> 32) * bound;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < bound) {
+            uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                product = (next() >> 32) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+    
+    // Uniform in [low, high], low <= high
+    int range(int low, int high) {
+        return low + static_cast<int>(below(static_cast<uint32_t>(high - low) + 1));
+    }
+    
+    // UniformRandomBitGenerator, for use with <algorithm>
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return UINT64_MAX; }
+    uint64_t operator()() { return next(); }
+};
+
+// A fresh non-zero seed from the OS entropy source
+inline uint64_t randomSeed() {
+    random_device device;
+    uint64_t seedValue = (static_cast<uint64_t>(device()) << 32) ^ device();
+    return seedValue != 0 ? seedValue : 1;
+}
+
+#endif // RANDOM_HPP
@@ -0,0 +1,286 @@
+/*
+ * RouteOptimizer.cpp - Parallel cost fields and backward Held-Karp ordering
+ */
+
+#include "RouteOptimizer.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <climits>
+
+using namespace std;
+using namespace sf;
+
+namespace {
+    const int UNREACHABLE = INT_MAX / 4;   // Sums of two stay below INT_MAX
+    
+    // Below this many cells a search takes less time than waking the workers
+    const int PARALLEL_MIN_CELLS = 1 << 14;
+    
+    inline bool isPassable(char cell, unsigned openDoors) {
+        int door = doorType(cell);
+        return cell != '#' && (door < 0 || (openDoors >> door) & 1);
+    }
+}
+
+RouteOptimizer::RouteOptimizer()
+    : cellCount(0),
+      sets(0) {
+}
+
+void RouteOptimizer::fillField(const MazeGrid& grid, int source, unsigned openDoors, int* field,
+                               BucketQueue& queue, long long& nodes) {
+    fill(field, field + cellCount, UNREACHABLE);
+    queue.reset(MAX_CELL_COST);
+    field[source] = 0;
+    queue.push(static_cast<uint64_t>(source), 0);
+    
+    while (!queue.empty()) {
+        int cost;
+        int current = static_cast<int>(queue.pop(cost));
+        if (cost != field[current]) {
+            continue;  // Stale entry
+        }
+        nodes++;
+        
+        for (int i = 0; i < 4; i++) {
+            int next = current + grid.neighborOffset(i);
+            if (!isPassable(grid[next], openDoors)) {
+                continue;
+            }
+            int nextCost = cost + grid.cost(next);
+            if (nextCost < field[next]) {
+                field[next] = nextCost;
+                queue.push(static_cast<uint64_t>(next), nextCost);
+            }
+        }
+    }
+}
+
+int RouteOptimizer::leg(int set, int from, int to) const {
+    int n = static_cast<int>(waypoints.size());
+    return legs[(static_cast<size_t>(set) * n + from) * (n + 1) + to];
+}
+
+int RouteOptimizer::fromStart(const MazeGrid& grid, int start, int set, int to) const {
+    // The field runs from 'to' outwards; walking it the other way pays for
+    // 'to' instead of the start
+    int field = fieldOf[static_cast<size_t>(to) * sets + set];
+    int cost = fields[static_cast<size_t>(field) * cellCount + start];
+    return cost < UNREACHABLE ? cost + grid.cost(targets[to]) - grid.cost(start) : UNREACHABLE;
+}
+
+bool RouteOptimizer::prepare(const MazeGrid& grid, const vector<Cell>& points, int goalRow, int goalCol,
+                             unsigned openDoors, SolveStats& stats) {
+    stats = SolveStats();
+    targets.clear();
+    waypoints = points;
+    
+    int n = static_cast<int>(waypoints.size());
+    if (n > MAX_WAYPOINTS || !grid.inBounds(goalRow, goalCol)) {
+        return false;
+    }
+    for (const Cell& waypoint : waypoints) {
+        if (!grid.inBounds(waypoint.row, waypoint.col)) {
+            return false;
+        }
+    }
+    
+    Clock timer;
+    cellCount = grid.getCellCount();
+    
+    // Keys still to be picked up at waypoints open more doors as the route
+    // goes on, so every combination of them gets its own fields
+    vector<unsigned> waypointKeys(n, 0);
+    unsigned routeKeys = 0;
+    for (int i = 0; i < n; i++) {
+        int type = keyType(grid.at(waypoints[i].row, waypoints[i].col));
+        if (type >= 0 && !((openDoors >> type) & 1)) {
+            waypointKeys[i] = 1u << type;
+            routeKeys |= waypointKeys[i];
+        }
+    }
+    vector<unsigned> keySets;
+    int setOf[1 << MAX_KEY_TYPES];
+    for (unsigned keys = routeKeys;; keys = (keys - 1) & routeKeys) {
+        setOf[keys] = static_cast<int>(keySets.size());
+        keySets.push_back(keys);
+        if (keys == 0) {
+            break;
+        }
+    }
+    sets = static_cast<int>(keySets.size());
+    
+    // A leg leaving a set of visited waypoints passes the doors their keys open
+    vector<unsigned> maskKeys(static_cast<size_t>(1) << n);
+    maskSet.resize(static_cast<size_t>(1) << n);
+    maskKeys[0] = 0;
+    maskSet[0] = setOf[0];
+    for (int top = 0; top < n; top++) {
+        for (int mask = 1 << top; mask < (2 << top); mask++) {
+            maskKeys[mask] = maskKeys[mask ^ (1 << top)] | waypointKeys[top];
+            maskSet[mask] = setOf[maskKeys[mask]];
+        }
+    }
+    
+    // A waypoint is only ever headed for while unvisited, so it needs
+    // fields just for the keys the other waypoints hold; the goal is
+    // reached with every route key
+    fieldOf.assign(static_cast<size_t>(n + 1) * sets, -1);
+    vector<int> fieldTarget;
+    vector<unsigned> fieldDoors;
+    for (int target = 0; target <= n; target++) {
+        unsigned others = 0;
+        for (int i = 0; i < n; i++) {
+            others |= i != target ? waypointKeys[i] : 0;
+        }
+        for (int set = 0; set < sets; set++) {
+            bool read = target < n ? (keySets[set] & ~others) == 0 : keySets[set] == routeKeys;
+            if (read) {
+                fieldOf[static_cast<size_t>(target) * sets + set] = static_cast<int>(fieldTarget.size());
+                fieldTarget.push_back(target);
+                fieldDoors.push_back(openDoors | keySets[set]);
+            }
+        }
+    }
+    int fieldCount = static_cast<int>(fieldTarget.size());
+    if (static_cast<int64_t>(fieldCount) * cellCount > FIELD_BUDGET) {
+        vector<int>().swap(fields);
+        return false;
+    }
+    
+    vector<int> cells(n + 1);
+    for (int i = 0; i < n; i++) {
+        cells[i] = grid.index(waypoints[i].row, waypoints[i].col);
+    }
+    cells[n] = grid.index(goalRow, goalCol);
+    
+    // One search per field, each filling its own slice
+    fields.resize(static_cast<size_t>(fieldCount) * cellCount);
+    expanded.assign(fieldCount, 0);
+    auto measure = [&](int field, int slot) {
+        fillField(grid, cells[fieldTarget[field]], fieldDoors[field],
+                  &fields[static_cast<size_t>(field) * cellCount], queues[slot], expanded[field]);
+    };
+    
+    ThreadPool& pool = ThreadPool::shared();
+    if (cellCount >= PARALLEL_MIN_CELLS && fieldCount > 1) {
+        if (queues.size() < static_cast<size_t>(pool.size())) {
+            queues.resize(pool.size());
+        }
+        pool.parallelFor(fieldCount, measure);
+    } else {
+        if (queues.empty()) {
+            queues.resize(1);
+        }
+        for (int field = 0; field < fieldCount; field++) {
+            measure(field, 0);
+        }
+    }
+    for (long long nodes : expanded) {
+        stats.nodesExpanded += nodes;
+    }
+    
+    // Waypoint-to-waypoint and waypoint-to-goal costs per key set, read
+    // from the target's field at the source
+    targets = cells;
+    legs.assign(static_cast<size_t>(sets) * n * (n + 1), UNREACHABLE);
+    for (int set = 0; set < sets; set++) {
+        for (int from = 0; from < n; from++) {
+            for (int to = 0; to <= n; to++) {
+                if (fieldOf[static_cast<size_t>(to) * sets + set] >= 0) {
+                    legs[(static_cast<size_t>(set) * n + from) * (n + 1) + to] =
+                        fromStart(grid, targets[from], set, to);
+                }
+            }
+        }
+    }
+    
+    // tail[S * n + last]: cheapest walk from waypoint 'last', just visited
+    // with everything outside S, through every waypoint in S to the goal
+    // (UNREACHABLE when 'last' is in S). Removing a waypoint from S gives a
+    // smaller mask, so ascending order has every entry's parts ready.
+    int full = (1 << n) - 1;
+    tail.resize((static_cast<size_t>(1) << n) * n);
+    for (int remaining = 0; remaining <= full && n > 0; remaining++) {
+        int set = maskSet[full ^ remaining];
+        int* row = &tail[static_cast<size_t>(remaining) * n];
+        for (int last = 0; last < n; last++) {
+            if ((remaining >> last) & 1) {
+                row[last] = UNREACHABLE;
+            } else if (remaining == 0) {
+                row[last] = leg(set, last, n);
+            } else {
+                int cheapest = UNREACHABLE;
+                for (int next = 0; next < n; next++) {
+                    if ((remaining >> next) & 1) {
+                        cheapest = min(cheapest, leg(set, last, next) +
+                                                 tail[static_cast<size_t>(remaining ^ (1 << next)) * n + next]);
+                    }
+                }
+                row[last] = cheapest;
+            }
+        }
+    }
+    
+    stats.milliseconds = timer.getElapsedTime().asMicroseconds() / 1000.f;
+    return true;
+}
+
+bool RouteOptimizer::solve(const MazeGrid& grid, int startRow, int startCol, unsigned remaining,
+                           RoutePlan& plan, SolveStats& stats) const {
+    plan = RoutePlan();
+    stats = SolveStats();
+    
+    int n = static_cast<int>(waypoints.size());
+    if (!isPrepared() || !grid.inBounds(startRow, startCol) || grid.getCellCount() != cellCount ||
+        (remaining >> n) != 0) {
+        return false;
+    }
+    
+    Clock timer;
+    int start = grid.index(startRow, startCol);
+    int full = (1 << n) - 1;
+    int set = maskSet[full ^ remaining];
+    
+    // First stop: one field lookup per remaining waypoint
+    int total = remaining == 0 ? fromStart(grid, start, set, n) : UNREACHABLE;
+    int first = -1;
+    for (int next = 0; next < n; next++) {
+        if (!((remaining >> next) & 1)) {
+            continue;
+        }
+        int cost = fromStart(grid, start, set, next) + tail[static_cast<size_t>(remaining ^ (1u << next)) * n + next];
+        if (cost < total) {
+            total = cost;
+            first = next;
+        }
+    }
+    
+    bool found = total < UNREACHABLE;
+    if (found) {
+        // Walk forwards, each time picking a next stop whose leg and tail
+        // account exactly for the rest of the cost
+        plan.cost = total;
+        unsigned left = remaining;
+        int at = first;
+        while (at >= 0) {
+            left &= ~(1u << at);
+            int rest = tail[static_cast<size_t>(left) * n + at];
+            plan.stops.push_back(Cell(waypoints[at].row, waypoints[at].col, total - rest));
+            int next = -1;
+            int legSet = maskSet[full ^ left];
+            for (int candidate = 0; candidate < n; candidate++) {
+                if (((left >> candidate) & 1) &&
+                    leg(legSet, at, candidate) + tail[static_cast<size_t>(left ^ (1u << candidate)) * n + candidate] == rest) {
+                    next = candidate;
+                    break;
+                }
+            }
+            at = next;
+        }
+        plan.stops.push_back(Cell(grid.rowOf(targets[n]), grid.colOf(targets[n]), total));
+    }
+    
+    stats.milliseconds = timer.getElapsedTime().asMicroseconds() / 1000.f;
+    return found;
+}
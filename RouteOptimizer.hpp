@@ -0,0 +1,97 @@
+/*
+ * RouteOptimizer.hpp - Cheapest visiting order for a set of waypoints
+ */
+
+#ifndef ROUTEOPTIMIZER_HPP
+#define ROUTEOPTIMIZER_HPP
+
+#include "Common.hpp"
+#include "MazeGrid.hpp"
+#include "PathSolver.hpp"
+#include "BucketQueue.hpp"
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Result of a route query
+struct RoutePlan {
+    vector<Cell> stops;   // Waypoints in visiting order, goal last; distance = cost so far
+    int cost;             // Total terrain cost from the start through every stop
+    
+    RoutePlan() : cost(-1) {}
+};
+
+// Visits every remaining waypoint before the goal at the lowest total
+// terrain cost, re-asked from wherever the player stands.
+//
+// prepare() does the heavy part once per level. Each waypoint and the goal
+// get a Dijkstra over the whole grid. Those searches are independent, so
+// they run in parallel on the shared thread pool, and each keeps its cost
+// field. Steps are undirected and pay for the cell entered, so one field
+// answers both ways: the cost from any cell p into waypoint w is
+// field_w[p] + cost(w) - cost(p). Held-Karp then runs backwards from the
+// goal once, in O(2^n * n^2) for n waypoints: tail[S][w] is the cheapest
+// way from w through every waypoint in S to the goal.
+//
+// solve() is then a lookup per remaining waypoint: the cheapest first stop
+// j minimises cost(start -> j) + tail[S - j][j]. That is microseconds at
+// any grid size, against a fresh set of searches over the grid per move.
+//
+// Doors whose bit is in 'openDoors' are open from the start; a key that is
+// itself a waypoint opens its doors for every leg after it is visited.
+// Each combination of such keys gets its own fields, so k distinct
+// waypoint keys multiply them by up to 2^k. Keys crossed between waypoints
+// open nothing.
+//
+// The fields cost 4 bytes per cell each; Level 3 (three checkpoints, one
+// key) needs 8 of them, 32 bytes per cell, more than the level itself.
+// Past FIELD_BUDGET cells of fields prepare() declines and the level has
+// no route readout.
+class RouteOptimizer {
+private:
+    vector<Cell> waypoints;               // As prepared; bit i of a 'remaining' mask is waypoints[i]
+    vector<int> targets;                  // Cell index of each waypoint, then the goal
+    int cellCount;
+    int sets;                             // Key sets with their own fields
+    vector<int> maskSet;                  // Visited waypoint mask -> key set its keys open
+    vector<int> fieldOf;                  // [target * sets + set] -> field, -1 if never read
+    vector<int> fields;                   // Cost from a target to every cell: [field * cellCount + idx]
+    vector<BucketQueue> queues;           // One per pool slot
+    vector<long long> expanded;           // Nodes expanded per field
+    vector<int> legs;                     // [(set * n + from) * (n + 1) + to], goal is to = n
+    vector<int> tail;                     // Held-Karp backwards: [remaining * n + last]
+    
+    void fillField(const MazeGrid& grid, int source, unsigned openDoors, int* field,
+                   BucketQueue& queue, long long& nodes);
+    int leg(int set, int from, int to) const;
+    int fromStart(const MazeGrid& grid, int start, int set, int to) const;
+    
+public:
+    // 2^16 * 16 DP cells is where exact ordering stops being instant
+    static const int MAX_WAYPOINTS = 16;
+    
+    // Field cells prepare() may fill, 256 MB
+    static const int64_t FIELD_BUDGET = int64_t(1) << 26;
+    
+    RouteOptimizer();
+    
+    // Measure 'waypoints' and the goal on 'grid' for later solve() calls.
+    // Fails if more than MAX_WAYPOINTS are given, a cell is off the grid
+    // or the fields would not fit in FIELD_BUDGET.
+    bool prepare(const MazeGrid& grid, const vector<Cell>& waypoints, int goalRow, int goalCol,
+                 unsigned openDoors, SolveStats& stats);
+    bool isPrepared() const { return !targets.empty(); }
+    const vector<Cell>& getWaypoints() const { return waypoints; }
+    
+    // Cheapest route from start through the prepared waypoints whose bit is
+    // set in 'remaining' (any order) to the goal. The others count as
+    // visited, their keys held. 'grid' is the prepared one; cells may have
+    // changed since only where their cost did not (a key picked up). The
+    // start must be passable with those keys, as the player's cell always is.
+    // Fails if not prepared or any remaining waypoint is cut off.
+    bool solve(const MazeGrid& grid, int startRow, int startCol, unsigned remaining,
+               RoutePlan& plan, SolveStats& stats) const;
+};
+
+#endif // ROUTEOPTIMIZER_HPP
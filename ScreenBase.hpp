@@ -24,6 +24,10 @@ public:
     
     virtual void draw() = 0;
     virtual optional<GameState> handleInput(const Event& event) { return nullopt; }
+    
+    // Milliseconds until the screen changes with no input (a blinking
+    // cursor, a clock), or -1 if only input changes it
+    virtual int getRedrawDelayMs() const { return -1; }
 };
 
 #endif // SCREENBASE_HPP
@@ -0,0 +1,31 @@
+/*
+ * SolverWorkspace.cpp - Reusable scratch buffers implementation
+ */
+
+#include "SolverWorkspace.hpp"
+#include <algorithm>
+
+using namespace std;
+
+SolverWorkspace::SolverWorkspace()
+    : epoch(0) {
+}
+
+void SolverWorkspace::begin(int cellCount) {
+    size_t size = static_cast<size_t>(max(0, cellCount));
+    if (stamps.size() < size) {
+        // New cells start with stamp 0, which is never a live epoch
+        stamps.resize(size, 0);
+        parent.resize(size);
+        cost.resize(size);
+        queue.resize(size);
+    }
+    open.clear();
+    
+    epoch++;
+    if (epoch == 0) {
+        // Counter wrapped: old stamps could collide, so clear them once
+        fill(stamps.begin(), stamps.end(), 0);
+        epoch = 1;
+    }
+}
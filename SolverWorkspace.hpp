@@ -0,0 +1,60 @@
+/*
+ * SolverWorkspace.hpp - Reusable scratch buffers for path searches
+ */
+
+#ifndef SOLVERWORKSPACE_HPP
+#define SOLVERWORKSPACE_HPP
+
+#include "BucketQueue.hpp"
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Entry of a best-first open list (A*, JPS)
+struct OpenEntry {
+    int priority;   // f = g + h
+    int cost;       // g when the entry was pushed; stale if it no longer matches
+    int idx;        // Linear cell index
+};
+
+// Visited flags, parent links and a flat queue shared by successive searches.
+// Buffers only grow, and starting a new search bumps an epoch counter instead
+// of clearing anything: a cell counts as visited only if its stamp matches the
+// current epoch. After the first search on a grid of a given size, searches
+// allocate nothing.
+class SolverWorkspace {
+private:
+    vector<uint32_t> stamps;   // Epoch in which each cell was last visited
+    uint32_t epoch;            // Current search generation
+    vector<int> parent;        // Predecessor of each visited cell
+    vector<int> cost;          // Best known cost of each visited cell
+    vector<int> queue;         // Flat FIFO, one slot per cell
+    vector<OpenEntry> open;    // Heap storage for best-first searches
+    BucketQueue buckets;       // Priority queue for weighted searches
+    
+public:
+    SolverWorkspace();
+    
+    // Prepare for a new search over cellCount cells (O(1) in steady state)
+    void begin(int cellCount);
+    
+    bool isVisited(int idx) const { return stamps[idx] == epoch; }
+    void visit(int idx, int from) { stamps[idx] = epoch; parent[idx] = from; }
+    int getParent(int idx) const { return parent[idx]; }
+    
+    // Cost-aware variant for weighted and best-first searches
+    void visit(int idx, int from, int c) { stamps[idx] = epoch; parent[idx] = from; cost[idx] = c; }
+    int getCost(int idx) const { return cost[idx]; }
+    
+    // Queue storage; BFS pushes every cell at most once, so no wrap-around
+    int* queueData() { return queue.data(); }
+    
+    // Open list for best-first searches; emptied by begin(), capacity kept
+    vector<OpenEntry>& openList() { return open; }
+    
+    // Bucket queue for weighted searches; callers reset() it with their max step cost
+    BucketQueue& bucketQueue() { return buckets; }
+};
+
+#endif // SOLVERWORKSPACE_HPP
@@ -0,0 +1,88 @@
+/*
+ * ThreadPool.cpp - Worker thread pool implementation
+ */
+
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+
+using namespace std;
+
+ThreadPool::ThreadPool(unsigned threadCount)
+    : stopping(false) {
+    if (threadCount == 0) {
+        threadCount = max(1u, thread::hardware_concurrency());
+    }
+    for (unsigned i = 0; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    taskReady.notify_all();
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        function<void()> task;
+        {
+            unique_lock<mutex> guard(lock);
+            taskReady.wait(guard, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;  // Stopping and drained
+            }
+            task = move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+void ThreadPool::submit(function<void()> task) {
+    {
+        lock_guard<mutex> guard(lock);
+        tasks.push(move(task));
+    }
+    taskReady.notify_one();
+}
+
+void ThreadPool::parallelFor(int count, const function<void(int index, int slot)>& body) {
+    if (count <= 0) {
+        return;
+    }
+    
+    // One task per slot; each pulls indices from a shared counter, so uneven
+    // items balance themselves out
+    int slots = min(count, size());
+    atomic<int> next(0);
+    int running = slots;
+    mutex doneLock;
+    condition_variable done;
+    
+    for (int slot = 0; slot < slots; slot++) {
+        submit([&, slot] {
+            for (int index = next++; index < count; index = next++) {
+                body(index, slot);
+            }
+            lock_guard<mutex> guard(doneLock);
+            if (--running == 0) {
+                done.notify_one();
+            }
+        });
+    }
+    
+    unique_lock<mutex> guard(doneLock);
+    done.wait(guard, [&] { return running == 0; });
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
@@ -0,0 +1,55 @@
+/*
+ * ThreadPool.hpp - Fixed set of worker threads for data-parallel work
+ */
+
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Workers are started once and sleep on a condition variable between jobs,
+// so handing out a batch of searches costs a wake-up rather than a thread
+// creation per search.
+//
+// parallelFor() blocks until the batch is done and must not be called from
+// inside a pool task (the caller would wait on workers that are all busy).
+class ThreadPool {
+private:
+    vector<thread> workers;
+    queue<function<void()>> tasks;
+    mutex lock;
+    condition_variable taskReady;
+    bool stopping;
+    
+    void workerLoop();
+    
+public:
+    // threadCount 0 = one worker per hardware thread
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    int size() const { return static_cast<int>(workers.size()); }
+    
+    // Queue a task to run on some worker
+    void submit(function<void()> task);
+    
+    // Run body(index, slot) for every index in [0, count). 'slot' is in
+    // [0, size()) and no two concurrent calls share one, so callers can
+    // index per-slot scratch buffers with it.
+    void parallelFor(int count, const function<void(int index, int slot)>& body);
+    
+    // Process-wide pool sized to the machine
+    static ThreadPool& shared();
+};
+
+#endif // THREADPOOL_HPP
@@ -5,15 +5,34 @@
 #include "GameEngine.hpp"
 #include "Common.hpp"
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdlib>
 
+using namespace std;
 using namespace sf;
 
-int main() {
-    // Calculate window size based on largest maze dimensions (Level 3: 15x20)
-    int mazeWidth = 20;   // Largest width (Level 3)
+namespace {
+    // Level 3 sizes accepted on the command line; Maze rounds them up to
+    // odd. A Level 3 holds about 18 bytes per cell, so the cap keeps the
+    // largest one under 2 GB.
+    const int MIN_LEVEL_SIDE = 5;
+    const int MAX_LEVEL_SIDE = 10001;
+    
+    int levelSide(const char* arg) {
+        return min(MAX_LEVEL_SIDE, max(MIN_LEVEL_SIDE, atoi(arg)));
+    }
+}
+
+// Usage: AlgoMaze [rows] [cols] - Level 3 size, square if only rows is given
+int main(int argc, char* argv[]) {
+    int levelRows = argc > 1 ? levelSide(argv[1]) : 0;
+    int levelCols = argc > 2 ? levelSide(argv[2]) : levelRows;
+    
+    // Window fits Level 3 (15x21) whole at 1:1; larger mazes scroll with the player
+    int mazeWidth = 21;   // Largest width (Level 3)
     int mazeHeight = 15;  // Largest height (Level 3)
     unsigned int windowWidth = mazeWidth * CELL_SIZE + WINDOW_PADDING * 2;
-    unsigned int windowHeight = mazeHeight * CELL_SIZE + WINDOW_PADDING * 2 + 150;  // Extra for text
+    unsigned int windowHeight = mazeHeight * CELL_SIZE + WINDOW_PADDING + HUD_HEIGHT;  // Map, then text
     
     // Create window (SFML 3.0 uses Vector2u)
     RenderWindow window(VideoMode(Vector2u(windowWidth, windowHeight)), 
@@ -21,7 +40,7 @@ int main() {
     window.setFramerateLimit(60);  // 60 FPS
     
     // Create and run the game engine
-    GameEngine game(&window);
+    GameEngine game(&window, levelRows, levelCols);
     game.run();
     
     return 0;
@@ -0,0 +1,88 @@
+/*
+ * BfsScalingBench.cpp - Serial vs parallel BFS scaling benchmark
+ *
+ * Usage: BfsScalingBench [rows] [cols] [wallPercent] [maxThreads]
+ *
+ * Builds a random grid (default 4000 x 4000, 25% walls), solves corner to
+ * corner with BfsSolver once and with ParallelBfsSolver on pools of 1..N
+ * threads, checks every parallel path against the serial one and prints
+ * the timings.
+ */
+
+#include "../ParallelBfsSolver.hpp"
+#include "../PathSolver.hpp"
+#include "../Random.hpp"
+#include "../ThreadPool.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+
+namespace {
+    const int RUNS = 3;   // Best of this many solves per configuration
+    
+    float bestTime(PathSolver& solver, const MazeGrid& grid, SolverWorkspace& workspace,
+                   vector<Cell>& path, SolveStats& stats) {
+        float best = -1.f;
+        for (int run = 0; run < RUNS; run++) {
+            solver.solve(grid, 0, 0, grid.getRows() - 1, grid.getCols() - 1, workspace, path, stats);
+            if (best < 0.f || stats.milliseconds < best) {
+                best = stats.milliseconds;
+            }
+        }
+        return best;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int rows = argc > 1 ? atoi(argv[1]) : 4000;
+    int cols = argc > 2 ? atoi(argv[2]) : 4000;
+    int wallPercent = argc > 3 ? atoi(argv[3]) : 25;
+    int maxThreads = argc > 4 ? atoi(argv[4]) : static_cast<int>(max(1u, thread::hardware_concurrency()));
+    
+    MazeGrid grid;
+    grid.assign(rows, cols, '.');
+    Rng rng(12345);   // Same grid on every platform
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            if (static_cast<int>(rng.below(100)) < wallPercent) {
+                grid.at(r, c) = '#';
+            }
+        }
+    }
+    grid.at(0, 0) = '.';
+    grid.at(rows - 1, cols - 1) = '.';
+    
+    SolverWorkspace workspace;
+    vector<Cell> serialPath, parallelPath;
+    SolveStats stats;
+    
+    unique_ptr<PathSolver> serial = createSolver(SolverType::BFS);
+    float serialTime = bestTime(*serial, grid, workspace, serialPath, stats);
+    cout << rows << " x " << cols << " grid, " << wallPercent << "% walls, path length "
+         << (serialPath.empty() ? -1 : static_cast<int>(serialPath.size()) - 1) << "\n";
+    cout << "serial BFS      " << serialTime << " ms\n";
+    
+    for (int threads = 1; threads <= maxThreads; threads++) {
+        ThreadPool pool(threads);
+        ParallelBfsSolver parallel(&pool);
+        float time = bestTime(parallel, grid, workspace, parallelPath, stats);
+        
+        bool identical = parallelPath.size() == serialPath.size();
+        for (size_t i = 0; identical && i < serialPath.size(); i++) {
+            identical = parallelPath[i].row == serialPath[i].row && parallelPath[i].col == serialPath[i].col;
+        }
+        
+        cout << "parallel x" << threads << (threads < 10 ? "     " : "    ") << time << " ms"
+             << "  speedup " << serialTime / time
+             << "  bottom-up layers " << parallel.getBottomUpLayers()
+             << (identical ? "" : "  PATH MISMATCH") << "\n";
+        if (!identical) {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * KeyBench.cpp - Measures KeySolver on key-gated grids
+ *
+ * Usage: KeyBench [shape] [rows] [cols] [keys] [seed]
+ *
+ * shape is open (a wall-less room), maze (a perfect backtracker maze) or
+ * both (default), at 1000 x 1000 with 8 keys by default. The keys 'q'.. are
+ * scattered over open cells and every one of them is required; the solver
+ * runs corner to corner. The time prepare() takes to build the heuristic
+ * fields, the states expanded, the search time and the route cost are
+ * printed, and the route is replayed step by step to check it is connected
+ * and collects every key.
+ */
+
+#include "../KeySolver.hpp"
+#include "../MazeGenerator.hpp"
+#include "../Random.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace sf;
+
+namespace {
+    // Walks the route and checks each step moves to an adjacent open cell
+    // and that every required key is held at the end
+    bool replayRoute(const MazeGrid& grid, const vector<Cell>& path, unsigned requiredKeys) {
+        unsigned held = 0;
+        for (size_t i = 0; i < path.size(); i++) {
+            const Cell& cell = path[i];
+            if (!grid.isOpen(grid.index(cell.row, cell.col))) {
+                return false;
+            }
+            if (i > 0 && abs(cell.row - path[i - 1].row) + abs(cell.col - path[i - 1].col) != 1) {
+                return false;
+            }
+            int type = keyType(grid.at(cell.row, cell.col));
+            if (type >= 0) {
+                held |= 1u << type;
+            }
+        }
+        return (held & requiredKeys) == requiredKeys;
+    }
+    
+    // Runs one shape; false if the search fails or returns a broken route
+    bool benchShape(const string& shape, int rows, int cols, int keys, uint64_t seed) {
+        MazeGrid grid;
+        int startRow = 0, startCol = 0;
+        int goalRow = rows - 1, goalCol = cols - 1;
+        if (shape == "open") {
+            grid.assign(rows, cols, '.');
+        } else if (shape == "maze") {
+            GeneratorConfig config(rows, cols, GeneratorAlgorithm::BACKTRACKER, seed);
+            MazeGenerator generator;
+            generator.generate(config, grid);
+            
+            // Rooms sit on odd coordinates inside the outer wall ring
+            startRow = startCol = 1;
+            goalRow = (grid.getRows() - 2) | 1;
+            goalCol = (grid.getCols() - 2) | 1;
+            goalRow -= goalRow >= grid.getRows() - 1 ? 2 : 0;
+            goalCol -= goalCol >= grid.getCols() - 1 ? 2 : 0;
+        } else {
+            cerr << "unknown shape " << shape << "\n";
+            return false;
+        }
+        
+        // Scatter the keys over open cells other than start and goal
+        Rng rng(seed);
+        unsigned requiredKeys = 0;
+        for (int type = 0; type < keys; type++) {
+            while (true) {
+                int r = rng.below(grid.getRows());
+                int c = rng.below(grid.getCols());
+                bool isEndpoint = (r == startRow && c == startCol) || (r == goalRow && c == goalCol);
+                if (grid.at(r, c) == '.' && !isEndpoint) {
+                    grid.at(r, c) = static_cast<char>('q' + type);
+                    requiredKeys |= 1u << type;
+                    break;
+                }
+            }
+        }
+        
+        cout << shape << " " << grid.getRows() << " x " << grid.getCols() << ", " << keys << " keys\n";
+        
+        KeySolver solver;
+        Clock timer;
+        solver.prepare(grid, goalRow, goalCol);
+        float prepareMs = timer.getElapsedTime().asMicroseconds() / 1000.f;
+        
+        vector<Cell> path;
+        SolveStats stats;
+        int cost = -1;
+        bool found = solver.solve(grid, startRow, startCol, 0, requiredKeys, path, cost, stats);
+        bool valid = found && replayRoute(grid, path, requiredKeys);
+        
+        cout << "  prepare: " << prepareMs << " ms\n";
+        cout << "  search: " << stats.nodesExpanded << " states, " << stats.milliseconds << " ms, cost "
+             << cost << ", length " << (found ? static_cast<int>(path.size()) - 1 : -1)
+             << (valid ? "" : "  INVALID ROUTE") << "\n";
+        return valid;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    string shape = argc > 1 ? argv[1] : "both";
+    int rows = argc > 2 ? atoi(argv[2]) : 1000;
+    int cols = argc > 3 ? atoi(argv[3]) : 1000;
+    int keys = argc > 4 ? max(0, min(MAX_KEY_TYPES, atoi(argv[4]))) : MAX_KEY_TYPES;
+    uint64_t seed = argc > 5 ? strtoull(argv[5], nullptr, 10) : 1;
+    
+    bool valid = true;
+    if (shape == "both") {
+        valid = benchShape("open", rows, cols, keys, seed) && valid;
+        valid = benchShape("maze", rows, cols, keys, seed) && valid;
+    } else {
+        valid = benchShape(shape, rows, cols, keys, seed);
+    }
+    return valid ? 0 : 1;
+}
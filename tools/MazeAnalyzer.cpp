@@ -0,0 +1,142 @@
+/*
+ * MazeAnalyzer.cpp - Batch maze quality metrics for generator tuning
+ *
+ * Usage: MazeAnalyzer [count] [rows] [cols] [algorithm] [loopDensity] [format] [firstSeed]
+ *
+ * Generates 'count' mazes (default 1000 of the Level 3 shape: 15 x 21,
+ * backtracker, loop density 0.25) from seeds firstSeed, firstSeed + 1, ...
+ * across the thread pool, measures each with MazeMetricsAnalyzer and
+ * prints one record per maze as csv (default) or json, in seed order.
+ * algorithm is backtracker, eller or tiled. Start and goal are the
+ * corners Maze::loadLevel uses. A summary goes to stderr.
+ */
+
+#include "../MazeGenerator.hpp"
+#include "../MazeMetrics.hpp"
+#include "../ThreadPool.hpp"
+#include <SFML/System.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    void printCsv(const vector<MazeMetrics>& results, uint64_t firstSeed) {
+        cout << "seed,open_cells,solution_length,dead_ends,junctions,branching_factor,loops,"
+                "components,corridors,mean_corridor_length,corridor_histogram\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const MazeMetrics& m = results[i];
+            cout << firstSeed + i << ',' << m.openCells << ',' << m.solutionLength << ','
+                 << m.deadEnds << ',' << m.junctions << ',' << m.branchingFactor << ','
+                 << m.loops << ',' << m.components << ',' << m.corridorCount << ','
+                 << m.meanCorridorLength << ',';
+            // Counts for corridor lengths 1, 2, ... separated by ';'
+            for (size_t length = 1; length < m.corridorLengths.size(); length++) {
+                cout << (length > 1 ? ";" : "") << m.corridorLengths[length];
+            }
+            cout << '\n';
+        }
+    }
+    
+    void printJson(const vector<MazeMetrics>& results, uint64_t firstSeed) {
+        cout << "[\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const MazeMetrics& m = results[i];
+            cout << "  {\"seed\": " << firstSeed + i
+                 << ", \"open_cells\": " << m.openCells
+                 << ", \"solution_length\": " << m.solutionLength
+                 << ", \"dead_ends\": " << m.deadEnds
+                 << ", \"junctions\": " << m.junctions
+                 << ", \"branching_factor\": " << m.branchingFactor
+                 << ", \"loops\": " << m.loops
+                 << ", \"components\": " << m.components
+                 << ", \"corridors\": " << m.corridorCount
+                 << ", \"mean_corridor_length\": " << m.meanCorridorLength
+                 << ", \"corridor_histogram\": [";
+            for (size_t length = 1; length < m.corridorLengths.size(); length++) {
+                cout << (length > 1 ? ", " : "") << m.corridorLengths[length];
+            }
+            cout << "]}" << (i + 1 < results.size() ? "," : "") << '\n';
+        }
+        cout << "]\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : 1000;
+    int rows = argc > 2 ? atoi(argv[2]) : 15;
+    int cols = argc > 3 ? atoi(argv[3]) : 21;
+    string algorithmName = argc > 4 ? argv[4] : "backtracker";
+    float loopDensity = argc > 5 ? static_cast<float>(atof(argv[5])) : 0.25f;
+    string format = argc > 6 ? argv[6] : "csv";
+    uint64_t firstSeed = argc > 7 ? strtoull(argv[7], nullptr, 10) : 1;
+    
+    GeneratorAlgorithm algorithm = GeneratorAlgorithm::BACKTRACKER;
+    if (algorithmName == "eller") {
+        algorithm = GeneratorAlgorithm::ELLER;
+    } else if (algorithmName == "tiled") {
+        algorithm = GeneratorAlgorithm::TILED;
+    } else if (algorithmName != "backtracker") {
+        cerr << "Unknown algorithm '" << algorithmName << "' (backtracker, eller, tiled)" << endl;
+        return 1;
+    }
+    if (count < 1 || rows < 3 || cols < 3 || firstSeed == 0 || (format != "csv" && format != "json")) {
+        cerr << "Usage: MazeAnalyzer [count] [rows] [cols] [algorithm] [loopDensity] [csv|json] [firstSeed >= 1]"
+             << endl;
+        return 1;
+    }
+    
+    // One generator, grid and analyzer per pool slot. Tiled generation
+    // would need the pool itself, so it gets a private one-thread pool.
+    ThreadPool& pool = ThreadPool::shared();
+    ThreadPool tilePool(1);
+    struct Worker {
+        unique_ptr<MazeGenerator> generator;
+        MazeGrid grid;
+        MazeMetricsAnalyzer analyzer;
+    };
+    vector<Worker> workers(pool.size());
+    for (Worker& worker : workers) {
+        worker.generator = make_unique<MazeGenerator>(&tilePool);
+    }
+    
+    vector<MazeMetrics> results(count);
+    sf::Clock timer;
+    pool.parallelFor(count, [&](int index, int slot) {
+        Worker& worker = workers[slot];
+        GeneratorConfig config(rows, cols, algorithm, firstSeed + index);
+        config.loopDensity = loopDensity;
+        worker.generator->generate(config, worker.grid);
+        
+        // Same endpoints as the generated level
+        worker.grid.at(1, 1) = '.';
+        worker.grid.at(rows - 2, cols - 2) = '.';
+        worker.analyzer.measure(worker.grid, 1, 1, rows - 2, cols - 2, results[index]);
+    });
+    float seconds = timer.getElapsedTime().asSeconds();
+    
+    if (format == "json") {
+        printJson(results, firstSeed);
+    } else {
+        printCsv(results, firstSeed);
+    }
+    
+    double solution = 0, deadEnds = 0, branching = 0, loops = 0, corridor = 0;
+    for (const MazeMetrics& m : results) {
+        solution += m.solutionLength;
+        deadEnds += m.deadEnds;
+        branching += m.branchingFactor;
+        loops += m.loops;
+        corridor += m.meanCorridorLength;
+    }
+    cerr << count << " mazes of " << rows << " x " << cols << " (" << algorithmName << ", loops "
+         << loopDensity << ") on " << pool.size() << " threads in " << seconds << " s\n"
+         << "mean solution " << solution / count << ", dead ends " << deadEnds / count
+         << ", branching " << branching / count << ", loops " << loops / count
+         << ", corridor length " << corridor / count << endl;
+    return 0;
+}
@@ -0,0 +1,53 @@
+/*
+ * MazeStream.cpp - Streams a huge perfect maze to a text file
+ *
+ * Usage: MazeStream [rows] [cols] [outputFile]
+ *
+ * Runs MazeGenerator::generateRows (Eller's algorithm) and writes each row
+ * as it is produced, so memory stays O(cols) however many rows are asked
+ * for. Writes to stdout when no file is given; prints the size and timing
+ * to stderr.
+ */
+
+#include "../MazeGenerator.hpp"
+#include <SFML/System.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int rows = argc > 1 ? atoi(argv[1]) : 100001;
+    int cols = argc > 2 ? atoi(argv[2]) : 1001;
+    if (rows < 1 || cols < 1) {
+        cerr << "Usage: MazeStream [rows] [cols] [outputFile]" << endl;
+        return 1;
+    }
+    
+    FILE* out = argc > 3 ? fopen(argv[3], "wb") : stdout;
+    if (!out) {
+        cerr << "Cannot open " << argv[3] << endl;
+        return 1;
+    }
+    
+    MazeGenerator generator;
+    sf::Clock timer;
+    bool failed = false;
+    generator.generateRows(GeneratorConfig(rows, cols, GeneratorAlgorithm::ELLER),
+                           [&](int, const string& line) {
+        failed |= fwrite(line.data(), 1, line.size(), out) != line.size() || fputc('\n', out) == EOF;
+    });
+    failed |= fflush(out) != 0;
+    if (out != stdout) {
+        failed |= fclose(out) != 0;
+    }
+    
+    cerr << rows << " x " << cols << " (" << static_cast<long long>(rows) * cols << " cells) in "
+         << timer.getElapsedTime().asMilliseconds() << " ms" << endl;
+    if (failed) {
+        cerr << "Write failed" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,250 @@
+/*
+ * SelfCheck.cpp - Invariant checks for the generators and solvers
+ *
+ * Usage: SelfCheck [seeds] [maxThreads]
+ *
+ * Runs each check over seeds 1..N (default 50) and prints one line per
+ * check with the number of failures:
+ *   - the same seed gives the same maze, for every algorithm
+ *   - tiled output does not depend on the thread count (pools of 1..N)
+ *   - generated mazes are connected, and perfect when loopDensity is 0
+ *   - every solver returns a valid path (start to goal, one orthogonal
+ *     step at a time over open cells); the step solvers and BitboardBFS
+ *     agree with BFS on its length, and Dijkstra's cost through mud is
+ *     what its path adds up to and no dearer than BFS's path
+ * Exits with 1 if anything failed.
+ */
+
+#include "../BitboardBFS.hpp"
+#include "../MazeGenerator.hpp"
+#include "../MazeMetrics.hpp"
+#include "../PathSolver.hpp"
+#include "../Random.hpp"
+#include "../ThreadPool.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+
+namespace {
+    const GeneratorAlgorithm ALGORITHMS[] = {
+        GeneratorAlgorithm::BACKTRACKER, GeneratorAlgorithm::ELLER, GeneratorAlgorithm::TILED
+    };
+    const char* const ALGORITHM_NAMES[] = {"backtracker", "eller", "tiled"};
+    
+    const SolverType CHECK_SOLVERS[] = {
+        SolverType::ASTAR, SolverType::JPS, SolverType::BIDIRECTIONAL,
+        SolverType::PARALLEL_BFS, SolverType::DIJKSTRA
+    };
+    
+    bool sameGrid(const MazeGrid& a, const MazeGrid& b) {
+        if (a.getRows() != b.getRows() || a.getCols() != b.getCols()) {
+            return false;
+        }
+        for (int r = 0; r < a.getRows(); r++) {
+            for (int c = 0; c < a.getCols(); c++) {
+                if (a.at(r, c) != b.at(r, c)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    
+    // Odd sizes keep the rooms' wall ring closed; small tiles give the
+    // tiled generator many tiles to hand out even on small grids
+    GeneratorConfig checkConfig(GeneratorAlgorithm algorithm, uint64_t seed) {
+        Rng rng(seed);
+        GeneratorConfig config(21 + 2 * rng.below(60), 21 + 2 * rng.below(60), algorithm, seed);
+        config.tileRooms = 4 + rng.below(8);
+        return config;
+    }
+    
+    // A solver's path must run from start to goal over open cells, each
+    // step moving to an orthogonal neighbour
+    bool validPath(const MazeGrid& grid, const vector<Cell>& path, int startRow, int startCol,
+                   int goalRow, int goalCol) {
+        if (path.empty() || path.front().row != startRow || path.front().col != startCol ||
+            path.back().row != goalRow || path.back().col != goalCol) {
+            return false;
+        }
+        for (size_t i = 0; i < path.size(); i++) {
+            if (!grid.inBounds(path[i].row, path[i].col) || !grid.isOpen(grid.index(path[i].row, path[i].col))) {
+                return false;
+            }
+            if (i > 0 && abs(path[i].row - path[i - 1].row) + abs(path[i].col - path[i - 1].col) != 1) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // Summed cellCost of every cell entered along 'path'
+    int pathCost(const MazeGrid& grid, const vector<Cell>& path) {
+        int cost = 0;
+        for (size_t i = 1; i < path.size(); i++) {
+            cost += grid.cost(grid.index(path[i].row, path[i].col));
+        }
+        return cost;
+    }
+    
+    bool report(const char* name, int failures, int checks) {
+        cout << (failures == 0 ? "ok    " : "FAIL  ") << name << ": " << checks - failures << " / " << checks << "\n";
+        return failures == 0;
+    }
+    
+    bool checkSameSeed(int seeds) {
+        int failures = 0, checks = 0;
+        for (GeneratorAlgorithm algorithm : ALGORITHMS) {
+            for (int seed = 1; seed <= seeds; seed++) {
+                GeneratorConfig config = checkConfig(algorithm, seed);
+                MazeGrid first, second;
+                MazeGenerator().generate(config, first);
+                MazeGenerator().generate(config, second);
+                failures += !sameGrid(first, second);
+                checks++;
+            }
+        }
+        return report("same seed, same maze", failures, checks);
+    }
+    
+    bool checkTiledThreads(int seeds, int maxThreads) {
+        int failures = 0, checks = 0;
+        vector<MazeGrid> reference(seeds);
+        for (int threads = 1; threads <= maxThreads; threads++) {
+            ThreadPool pool(threads);
+            MazeGenerator generator(&pool);
+            for (int seed = 1; seed <= seeds; seed++) {
+                GeneratorConfig config = checkConfig(GeneratorAlgorithm::TILED, seed);
+                if (threads == 1) {
+                    generator.generate(config, reference[seed - 1]);
+                    continue;
+                }
+                MazeGrid grid;
+                generator.generate(config, grid);
+                failures += !sameGrid(grid, reference[seed - 1]);
+                checks++;
+            }
+        }
+        return report("tiled output independent of thread count", failures, checks);
+    }
+    
+    bool checkPerfect(int seeds) {
+        MazeMetricsAnalyzer analyzer;
+        MazeMetrics metrics;
+        bool passed = true;
+        for (int a = 0; a < 3; a++) {
+            int failures = 0, checks = 0;
+            for (int seed = 1; seed <= seeds; seed++) {
+                // Perfect: one component and no cycles. Braided: still one component.
+                GeneratorConfig config = checkConfig(ALGORITHMS[a], seed);
+                MazeGrid grid;
+                MazeGenerator().generate(config, grid);
+                analyzer.measure(grid, 1, 1, 1, 1, metrics);
+                failures += metrics.components != 1 || metrics.loops != 0;
+                
+                config.loopDensity = 0.25f;
+                MazeGenerator().generate(config, grid);
+                analyzer.measure(grid, 1, 1, 1, 1, metrics);
+                failures += metrics.components != 1;
+                checks += 2;
+            }
+            string name = string(ALGORITHM_NAMES[a]) + " mazes connected and perfect";
+            passed = report(name.c_str(), failures, checks) && passed;
+        }
+        return passed;
+    }
+    
+    bool checkSolvers(int seeds) {
+        SolverWorkspace workspace;
+        BitboardBFS bitboard;
+        vector<Cell> path;
+        SolveStats stats;
+        unique_ptr<PathSolver> bfs = createSolver(SolverType::BFS);
+        
+        int failures = 0, checks = 0;
+        for (int seed = 1; seed <= seeds; seed++) {
+            // Random walls give open areas, dead ends and unreachable goals;
+            // every other seed spreads mud over the floor as well
+            Rng rng(seed);
+            int rows = 10 + rng.below(200);
+            int cols = 10 + rng.below(200);
+            int wallPercent = rng.below(45);
+            int mudPercent = seed % 2 == 0 ? 5 + rng.below(40) : 0;
+            MazeGrid grid;
+            grid.assign(rows, cols, '.');
+            for (int r = 0; r < rows; r++) {
+                for (int c = 0; c < cols; c++) {
+                    int roll = static_cast<int>(rng.below(100));
+                    if (roll < wallPercent) {
+                        grid.at(r, c) = '#';
+                    } else if (roll < wallPercent + mudPercent) {
+                        grid.at(r, c) = '~';
+                    }
+                }
+            }
+            grid.at(0, 0) = '.';
+            grid.at(rows - 1, cols - 1) = '.';
+            int goal = grid.index(rows - 1, cols - 1);
+            
+            bool found = bfs->solve(grid, 0, 0, rows - 1, cols - 1, workspace, path, stats);
+            int expected = found ? static_cast<int>(path.size()) - 1 : -1;
+            int bfsCost = found ? pathCost(grid, path) : -1;
+            if (found && !validPath(grid, path, 0, 0, rows - 1, cols - 1)) {
+                cout << "  seed " << seed << ": BFS path invalid\n";
+                failures++;
+            }
+            checks++;
+            
+            for (SolverType type : CHECK_SOLVERS) {
+                unique_ptr<PathSolver> solver = createSolver(type);
+                bool solved = solver->solve(grid, 0, 0, rows - 1, cols - 1, workspace, path, stats);
+                int length = solved ? static_cast<int>(path.size()) - 1 : -1;
+                
+                // Without mud every step costs the same, so Dijkstra's
+                // cheapest path is a shortest one too
+                bool weighted = type == SolverType::DIJKSTRA && mudPercent > 0;
+                if (solved && !validPath(grid, path, 0, 0, rows - 1, cols - 1)) {
+                    cout << "  seed " << seed << ": " << solver->getName() << " path invalid\n";
+                    failures++;
+                } else if (weighted ? solved != found : length != expected) {
+                    cout << "  seed " << seed << ": " << solver->getName() << " length " << length
+                         << ", BFS " << expected << "\n";
+                    failures++;
+                } else if (type == SolverType::DIJKSTRA && solved) {
+                    // The cost Dijkstra settled the goal at must be what its
+                    // path adds up to, and no path (BFS's included) cheaper
+                    int cost = workspace.getCost(goal);
+                    if (cost != pathCost(grid, path) || cost > bfsCost) {
+                        cout << "  seed " << seed << ": Dijkstra cost " << cost << ", path sums to "
+                             << pathCost(grid, path) << ", BFS path " << bfsCost << "\n";
+                        failures++;
+                    }
+                }
+                checks++;
+            }
+            
+            bitboard.build(grid);
+            int distance = bitboard.distance(0, 0, rows - 1, cols - 1).value_or(-1);
+            if (distance != expected) {
+                cout << "  seed " << seed << ": BitboardBFS distance " << distance << ", BFS " << expected << "\n";
+                failures++;
+            }
+            checks++;
+        }
+        return report("solver paths valid, lengths equal BFS, Dijkstra costs add up", failures, checks);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int seeds = argc > 1 ? max(1, atoi(argv[1])) : 50;
+    int maxThreads = argc > 2 ? atoi(argv[2]) : static_cast<int>(max(2u, thread::hardware_concurrency()));
+    
+    bool passed = checkSameSeed(seeds);
+    passed = checkTiledThreads(seeds, max(2, maxThreads)) && passed;
+    passed = checkPerfect(seeds) && passed;
+    passed = checkSolvers(seeds) && passed;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+/*
+ * SolverBench.cpp - Compares the path solvers across maze shapes
+ *
+ * Usage: SolverBench [shape] [rows] [cols] [seed]
+ *
+ * shape is open (a wall-less room), maze (a perfect backtracker maze),
+ * loops (backtracker with a quarter of the spare walls removed), random
+ * (25% random walls) or all (default), at 500 x 500 by default. Each
+ * solver runs corner to corner; the nodes it expanded, its time and the
+ * path length are printed, every solver's length is checked against BFS,
+ * and selectFastestSolver() names the strategy it would pick for the shape.
+ */
+
+#include "../MazeGenerator.hpp"
+#include "../PathSolver.hpp"
+#include "../Random.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    const SolverType BENCH_SOLVERS[] = {
+        SolverType::BFS, SolverType::ASTAR, SolverType::JPS, SolverType::BIDIRECTIONAL,
+        SolverType::PARALLEL_BFS, SolverType::DIJKSTRA
+    };
+    
+    const char* const SHAPES[] = {"open", "maze", "loops", "random"};
+    
+    // Fills 'grid' with the named shape; returns false for an unknown name
+    bool buildShape(const string& shape, int rows, int cols, uint64_t seed, MazeGrid& grid) {
+        if (shape == "open") {
+            grid.assign(rows, cols, '.');
+        } else if (shape == "maze" || shape == "loops") {
+            GeneratorConfig config(rows, cols, GeneratorAlgorithm::BACKTRACKER, seed);
+            config.loopDensity = shape == "loops" ? 0.25f : 0.f;
+            MazeGenerator generator;
+            generator.generate(config, grid);
+        } else if (shape == "random") {
+            grid.assign(rows, cols, '.');
+            Rng rng(seed);
+            for (int r = 0; r < rows; r++) {
+                for (int c = 0; c < cols; c++) {
+                    if (rng.below(100) < 25) {
+                        grid.at(r, c) = '#';
+                    }
+                }
+            }
+        } else {
+            return false;
+        }
+        return true;
+    }
+    
+    // Runs every solver on one shape; false if any path length disagrees with BFS
+    bool benchShape(const string& shape, int rows, int cols, uint64_t seed) {
+        MazeGrid grid;
+        if (!buildShape(shape, rows, cols, seed, grid)) {
+            cerr << "unknown shape " << shape << "\n";
+            return false;
+        }
+        
+        // Generated mazes keep their outer wall ring and carve rooms on odd
+        // coordinates, so they run between the first and last rooms
+        int startRow = 0, startCol = 0;
+        int goalRow = grid.getRows() - 1, goalCol = grid.getCols() - 1;
+        if (shape == "maze" || shape == "loops") {
+            startRow = startCol = 1;
+            goalRow = (grid.getRows() - 2) | 1;
+            goalCol = (grid.getCols() - 2) | 1;
+            goalRow -= goalRow >= grid.getRows() - 1 ? 2 : 0;
+            goalCol -= goalCol >= grid.getCols() - 1 ? 2 : 0;
+        }
+        grid.at(startRow, startCol) = '.';
+        grid.at(goalRow, goalCol) = '.';
+        
+        cout << shape << " " << grid.getRows() << " x " << grid.getCols() << "\n";
+        SolverWorkspace workspace;
+        vector<Cell> path;
+        SolveStats stats;
+        int bfsLength = -2;
+        bool agree = true;
+        for (SolverType type : BENCH_SOLVERS) {
+            unique_ptr<PathSolver> solver = createSolver(type);
+            bool found = solver->solve(grid, startRow, startCol, goalRow, goalCol, workspace, path, stats);
+            int length = found ? static_cast<int>(path.size()) - 1 : -1;
+            if (type == SolverType::BFS) {
+                bfsLength = length;
+            }
+            bool match = length == bfsLength;
+            agree = agree && match;
+            cout << "  " << solver->getName() << ": " << stats.nodesExpanded << " nodes, "
+                 << stats.milliseconds << " ms, length " << length << (match ? "" : "  LENGTH MISMATCH") << "\n";
+        }
+        
+        SolverType fastest = selectFastestSolver(grid, startRow, startCol, goalRow, goalCol, workspace);
+        cout << "  fastest: " << createSolver(fastest)->getName() << "\n";
+        return agree;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    string shape = argc > 1 ? argv[1] : "all";
+    int rows = argc > 2 ? atoi(argv[2]) : 500;
+    int cols = argc > 3 ? atoi(argv[3]) : 500;
+    uint64_t seed = argc > 4 ? strtoull(argv[4], nullptr, 10) : 1;
+    
+    bool agree = true;
+    if (shape == "all") {
+        for (const char* name : SHAPES) {
+            agree = benchShape(name, rows, cols, seed) && agree;
+        }
+    } else {
+        agree = benchShape(shape, rows, cols, seed);
+    }
+    return agree ? 0 : 1;
+}